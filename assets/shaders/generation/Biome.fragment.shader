@@ -2,7 +2,6 @@
 #version 330
 
 #include <shaders/Mathematics.include>
-#include <shaders/Noise.include>
 
 #ifdef ORIGIN_UPPER_LEFT
 	layout(origin_upper_left) in vec4 gl_FragCoord;
@@ -12,17 +11,43 @@ uniform sampler2D uElevationMap;
 uniform sampler2D uTemperatureMap;
 uniform sampler2D uPrecipitationMap;
 
-uniform float uSeaLevel = 0.0;
+// tables of the biome classifier, which yield the same biomes as on the CPU
+// palette indices of land by temperature (rows) and precipitation (columns) in 8 bit
+uniform usampler2D uLandBiomes;
+// a pixel belongs to the first band whose lower bound it exceeds, the last band has no bound
+uniform float uBounds[7];
+uniform int uBandBiomes[8];
+uniform int uBandCount = 1;
+uniform vec3 uPalette[32];
 
-in vec2 Texinates;
+const int Land = 255;
 
 out vec4 Output; 
 
+// converts like the readback of the map into 8 bit
+int quantize(float value) {
+	return int(clamp(value, 0.0, 1.0) * 255.0 + 0.5);
+}
+
 void main() {
 
-	float elevation = texture(uElevationMap, Texinates).x;
+	// fetches exact texels, since filtering could change the values next to a bound
+	ivec2 texel = ivec2(gl_FragCoord.xy);
+	float elevation = texelFetch(uElevationMap, texel, 0).r;
+
+	int band = uBandCount - 1;
+	for (int bound = uBandCount - 2; bound >= 0; bound--) {
+		if (elevation > uBounds[bound]) band = bound;
+	}
+
+	int biome = uBandBiomes[band];
+	if (biome == Land) {
+		int temperature = quantize(texelFetch(uTemperatureMap, texel, 0).r);
+		int precipitation = quantize(texelFetch(uPrecipitationMap, texel, 0).r);
+		biome = int(texelFetch(uLandBiomes, ivec2(precipitation, temperature), 0).r);
+	}
 
-	Output.rgb = vec3(temperature);
+	Output.rgb = uPalette[biome];
 	Output.a = 1.0;
 
 }
@@ -10,6 +10,7 @@
 
 uniform bool uWrapping = false;
 uniform uvec2 uResolution;
+uniform float uPixelSize = 1.0; // in pixels of uResolution, larger while previewing at a lower resolution
 uniform int uSeed;
 uniform vec2 uShift = vec2(0.0, 0.0);
 uniform float uScale = 1.0;
@@ -39,7 +40,7 @@ void main() {
 	float regional_elevation;
 	
 	vec2 center = vec2(uResolution) / 2.0;
-	vec2 position = gl_FragCoord.xy;
+	vec2 position = gl_FragCoord.xy * uPixelSize;
 	if (uWrapping) {
 		float repeat_interval = uResolution.x / uScale;
 		position.y = (position.y - center.y) / uScale + center.y;
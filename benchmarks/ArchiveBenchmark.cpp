@@ -0,0 +1,62 @@
+#include <sethex/world/Archive.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace cinder;
+using namespace std;
+
+namespace {
+
+	// generates a preset at the full resolution of the interface with the CPU stages, like the headless generator
+	GenerationMaps generate(unsigned preset) {
+		WorldParameters parameters;
+		parameters.apply_preset(preset, true);
+		unsigned2 resolution(1600, 900);
+		ElevationSection section;
+		section.size = signed2(resolution);
+		section.full_resolution = resolution;
+		Simplex::Generator simplex;
+		simplex.seed(parameters.seed);
+		Simplex::Batch batch(simplex);
+		BiomeClassifier classifier(parameters.get_biome_determination(), [&](uint8 temperature) { return parameters.normalize_temperature(temperature); });
+		GenerationMaps maps;
+		Job job;
+		job.stage("Tectonic", [&](Job& job) { generate_elevation(parameters, batch, section, job, maps); });
+		job.stage("Topography", [&](Job& job) { generate_topography(parameters, simplex, resolution, 1, job, maps); });
+		job.stage("Climate", [&](Job& job) { generate_linear_climate(parameters, resolution, job, maps); });
+		job.stage("Biomes", [&](Job& job) { classify_biomes(classifier, resolution, job, maps); });
+		job.start();
+		job.wait();
+		return maps;
+	}
+
+	// compression ratio, writing and decoding speed of the archives of the presets, which can be generated without a graphics context
+	// the speeds are given in MB of decoded maps (elevations as float) per second
+	void benchmark_archive() {
+		auto path = fs::temp_directory_path() / "sethex-benchmark.archive";
+		auto& presets = WorldParameters::preset_list;
+		for (unsigned preset = 0; preset < presets.size(); preset++) {
+			// the elevation of the earth is composed of elevation maps by a shader
+			if (presets[preset] == "Earth") continue;
+			auto maps = generate(preset);
+			WorldParameters parameters;
+			parameters.apply_preset(preset, true);
+			double writing = benchmarking::measure([&] {
+				WorldArchive::write(path, parameters, *maps.elevation_map, *maps.temperature_map, *maps.precipitation_map, *maps.biome_map);
+			}, 5);
+			WorldArchive archive(path);
+			double megabytes = archive.get_decoded_size() / 1048576.0;
+			double decoding = benchmarking::measure([&] { archive.decode_all(); });
+			auto name = "Archive " + presets[preset];
+			benchmarking::report(name + " ratio", static_cast<double>(archive.get_decoded_size()) / archive.get_compressed_size(), ": 1");
+			benchmarking::report(name + " writing", megabytes / writing, "MB/s");
+			benchmarking::report(name + " decoding", megabytes / decoding, "MB/s");
+		}
+		fs::remove(path);
+	}
+
+	benchmarking::Registration archive("Archive", benchmark_archive);
+
+}
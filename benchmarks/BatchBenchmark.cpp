@@ -0,0 +1,63 @@
+#include <random>
+
+#include <hexagonal/Map.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	// throughput of the batch conversions compared with converting one cell at a time, for the cells of a 2048x1024 map
+	void benchmark_batch() {
+		hex::Map map(2048, 1024);
+		auto& cells = map.coordinates();
+		size_t count = cells.size();
+		Lot<float2> cartesian(count);
+		Lot<float3> positions(count);
+		Lot<float2> texinates(count);
+		Lot<Cell> converted(count);
+		double megacells = count / 1e6;
+		auto report = [&](const string& name, double seconds) {
+			benchmarking::report(name, megacells / seconds, "Mcells/s");
+		};
+
+		report("Cartesian single", benchmarking::measure([&] {
+			for (size_t index = 0; index < count; index++) cartesian[index] = cells[index].to_cartesian();
+		}));
+		report("Cartesian batch", benchmarking::measure([&] { batch::to_cartesian(cells.data(), cartesian.data(), count); }));
+		report("Positions single", benchmarking::measure([&] {
+			for (size_t index = 0; index < count; index++) positions[index] = cells[index].to_position();
+		}));
+		report("Positions batch", benchmarking::measure([&] { batch::to_positions(cells.data(), positions.data(), count); }));
+		// positions between the centers of the cells exercise the rounding
+		mt19937 random(7);
+		uniform_real_distribution<float> jitter(-0.4f, 0.4f);
+		for (auto& position : positions) position += float3(jitter(random), 0.0f, jitter(random));
+		report("Cells of positions single", benchmarking::measure([&] {
+			for (size_t index = 0; index < count; index++) converted[index] = Cell::of(positions[index]);
+		}));
+		report("Cells of positions batch", benchmarking::measure([&] { batch::cells_of(positions.data(), converted.data(), count); }));
+		report("Texinates single", benchmarking::measure([&] {
+			for (size_t index = 0; index < count; index++) texinates[index] = map.texinates(cells[index]);
+		}));
+		report("Texinates batch", benchmarking::measure([&] { map.texinates(cells.data(), texinates.data(), count); }));
+		// the tile system converts the tiles of one chunk of 64x64 cells at a time, which stay within the cache
+		const size_t Chunk = 64 * 64;
+		report("Texinates of chunks single", benchmarking::measure([&] {
+			for (size_t begin = 0; begin < count; begin += Chunk) {
+				for (size_t index = 0; index < Chunk; index++) texinates[index] = map.texinates(cells[index]);
+			}
+		}));
+		report("Texinates of chunks batch", benchmarking::measure([&] {
+			for (size_t begin = 0; begin < count; begin += Chunk) map.texinates(cells.data(), texinates.data(), Chunk);
+		}));
+		benchmarking::consume(texinates[count / 2]);
+		benchmarking::consume(converted[count / 2]);
+	}
+
+	benchmarking::Registration batch_conversions("Batch", benchmark_batch);
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Measurements of the portable build, which are run by the Benchmarks executable and reported as lines of "name: value unit".
+// Each benchmark is registered by a static Registration in the file of its area, the results are committed in Results.txt.
+namespace benchmarking {
+
+	// median seconds of "repetitions" runs of "function", which is run once before to warm up the caches
+	template<class Function>
+	double measure(Function&& function, unsigned repetitions = 9) {
+		function();
+		std::vector<double> seconds;
+		for (unsigned repetition = 0; repetition < repetitions; repetition++) {
+			auto start = std::chrono::steady_clock::now();
+			function();
+			seconds.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+		std::nth_element(seconds.begin(), seconds.begin() + seconds.size() / 2, seconds.end());
+		return seconds[seconds.size() / 2];
+	}
+
+	void report(const std::string& name, double value, const char* unit);
+
+	// number of heap allocations so far, which are counted by the global operator new of the benchmarks
+	std::size_t allocations();
+
+	inline volatile char sink;
+
+	// keeps the compiler from removing the computation of "value"
+	template<class Type>
+	void consume(const Type& value) {
+		sink = *reinterpret_cast<const volatile char*>(&value);
+	}
+
+	struct Benchmark {
+		const char* name;
+		void (*run)();
+	};
+
+	std::vector<Benchmark>& registry();
+
+	struct Registration {
+		Registration(const char* name, void (*run)()) {
+			registry().push_back({ name, run });
+		}
+	};
+
+}
@@ -0,0 +1,66 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+
+#include "Benchmark.h"
+
+using namespace std;
+
+namespace {
+
+	atomic<size_t> allocation_count { 0 };
+
+}
+
+// counts the allocations of all benchmarks, the array forms of new and delete call these
+void* operator new(size_t size) {
+	allocation_count++;
+	if (void* memory = malloc(size ? size : 1)) return memory;
+	throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+	free(memory);
+}
+
+namespace benchmarking {
+
+	size_t allocations() {
+		return allocation_count;
+	}
+
+	void report(const string& name, double value, const char* unit) {
+		cout << name << ": " << fixed << setprecision(value < 10.0 ? 2 : 1) << value << ' ' << unit << endl;
+	}
+
+	vector<Benchmark>& registry() {
+		static vector<Benchmark> benchmarks;
+		return benchmarks;
+	}
+
+}
+
+// runs all benchmarks or those whose names are given, e.g. "Benchmarks Archive"
+int main(int argc, char* argv[]) {
+	int failures = 0;
+	for (auto& benchmark : benchmarking::registry()) {
+		bool selected = argc == 1;
+		for (int index = 1; index < argc; index++) selected |= strcmp(argv[index], benchmark.name) == 0;
+		if (not selected) continue;
+		cout << "# " << benchmark.name << endl;
+		try {
+			benchmark.run();
+		} catch (const exception& exception) {
+			cerr << benchmark.name << ": " << exception.what() << endl;
+			failures++;
+		}
+	}
+	return failures ? 1 : 0;
+}
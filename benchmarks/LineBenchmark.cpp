@@ -0,0 +1,60 @@
+#include <iostream>
+#include <random>
+
+#include <hexagonal/Ranges.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	// discards the traced messages, whose formatting is measured instead of the console
+	class Discarding : public streambuf {
+
+	protected:
+
+		int overflow(int character) override {
+			return character;
+		}
+
+		streamsize xsputn(const char*, streamsize count) override {
+			return count;
+		}
+
+	};
+
+	// time per step of rasterizing lines, whose steps are traced unless tracing is compiled out
+	// the Benchmarks executable uses the level of the build type, TracingBenchmarks enables tracing (TENJIX_LOGGING_LEVEL 0)
+	void benchmark_line() {
+		mt19937 random(7);
+		uniform_int_distribution<int> offset(-40, 40);
+		Lot<pair<Cell, Cell>> lines;
+		for (unsigned line = 0; line < 1000; line++) {
+			lines.emplace_back(Cell(), Cell(offset(random), offset(random)));
+		}
+		unsigned steps = 0;
+		int sum = 0;
+		auto rasterize = [&] {
+			steps = 0;
+			for (auto& line : lines) {
+				for (auto& cell : line_range(line.first, line.second, true)) {
+					sum += cell.u;
+					steps++;
+				}
+			}
+		};
+		Discarding discarding;
+		auto console = cout.rdbuf(&discarding);
+		double seconds = benchmarking::measure(rasterize);
+		cout.rdbuf(console);
+		auto name = stringify("Line step (logging level ", TENJIX_LOGGING_LEVEL, TENJIX_LOGGING_LEVEL == 0 ? ", traced)" : ", tracing compiled out)");
+		benchmarking::report(name, seconds / steps * 1e9, "ns");
+		benchmarking::consume(sum);
+	}
+
+	benchmarking::Registration line("Line", benchmark_line);
+
+}
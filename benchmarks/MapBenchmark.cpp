@@ -0,0 +1,69 @@
+#include <random>
+
+#include <hexagonal/Map.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	const unsigned Lookups = 1 << 22;
+
+	// index of the implementation before the branch-free one, which wrapped columns and rows with project() if they exceeded the map
+	unsigned projected_index(const hex::Map& map, const Cell& coordinates) {
+		int width = map.width();
+		int height = map.height();
+		int column = map.column(coordinates);
+		int row = map.row(coordinates);
+		if (column < 0 or column >= width) column = project(column, 0, width - 1);
+		if (row < 0 or row >= height) row = project(row, 0, height - 1);
+		return column + row * width;
+	}
+
+	// lookups of cells within a map in sequential and random order and of cells around it, which are mostly wrapped
+	void benchmark_map(unsigned width, unsigned height) {
+		hex::Map map(width, height, false);
+		Lot<Cell> sequential(Lookups), random_inside(Lookups), random_outside(Lookups);
+		mt19937 random(7);
+		uniform_int_distribution<unsigned> column(0, width - 1), row(0, height - 1);
+		uniform_int_distribution<int> shift_u(-static_cast<int>(width), width), shift_v(-static_cast<int>(height), height);
+		for (unsigned lookup = 0; lookup < Lookups; lookup++) {
+			unsigned index = lookup % (width * height);
+			sequential[lookup] = map.at(index % width, index / width);
+			random_inside[lookup] = map.at(column(random), row(random));
+			random_outside[lookup] = random_inside[lookup] + Cell(shift_u(random), shift_v(random));
+		}
+		unsigned sum = 0;
+		auto lookup = [&](const string& name, const Lot<Cell>& cells, auto index) {
+			double seconds = benchmarking::measure([&] {
+				for (auto& cell : cells) sum += index(cell);
+			}, 5);
+			benchmarking::report(stringify("Map ", width, "x", height, " ", name), seconds / Lookups * 1e9, "ns per index");
+		};
+		auto projected = [&](const Cell& cell) { return projected_index(map, cell); };
+		auto checked = [&](const Cell& cell) { return map.index(cell); };
+		auto unchecked = [&](const Cell& cell) { return map.index_unchecked(cell); };
+		auto wrapped = [&](const Cell& cell) { return map.wrapped_index(cell); };
+		lookup("sequential, previous index", sequential, projected);
+		lookup("sequential, index", sequential, checked);
+		lookup("sequential, index_unchecked", sequential, unchecked);
+		lookup("random, previous index", random_inside, projected);
+		lookup("random, index", random_inside, checked);
+		lookup("random, index_unchecked", random_inside, unchecked);
+		lookup("random outside, previous index", random_outside, projected);
+		lookup("random outside, index", random_outside, checked);
+		lookup("random outside, wrapped_index", random_outside, wrapped);
+		benchmarking::consume(sum);
+	}
+
+	void benchmark_maps() {
+		benchmark_map(256, 256);
+		benchmark_map(4096, 4096);
+	}
+
+	benchmarking::Registration maps("Map", benchmark_maps);
+
+}
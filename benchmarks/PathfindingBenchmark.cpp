@@ -0,0 +1,141 @@
+#include <cmath>
+#include <random>
+
+#include <hexagonal/HierarchicalPathfinding.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	// smooth terrain with costs between 1 and 3 per step, ridges which are impassable and elevations which make climbing expensive
+	struct Terrain {
+
+		hex::Map map;
+		Lot<float> base_costs;
+		Lot<float> elevations;
+
+		Terrain(unsigned width, unsigned height) : map(width, height, false) {
+			base_costs.resize(width * height);
+			elevations.resize(width * height);
+			for (unsigned row = 0; row < height; row++) {
+				for (unsigned column = 0; column < width; column++) {
+					float x = static_cast<float>(column), y = static_cast<float>(row);
+					float ridges = sin(x * 0.031f + 1.7f * sin(y * 0.013f)) * sin(y * 0.027f + 1.3f * sin(x * 0.011f));
+					unsigned index = column + row * width;
+					base_costs[index] = ridges > 0.85f ? Infinite_Cost : 2.0f + sin(x * 0.07f) * cos(y * 0.05f);
+					elevations[index] = 4.0f * ridges;
+				}
+			}
+		}
+
+		TerrainCosts costs() const {
+			return TerrainCosts(map, base_costs.data(), elevations.data(), 0.5f);
+		}
+
+		// random pairs of passable cells which are at most "range" columns and rows apart
+		Lot<pair<Cell, Cell>> queries(unsigned count, unsigned range, unsigned seed) const {
+			mt19937 random(seed);
+			uniform_int_distribution<unsigned> column(0, map.width() - 1), row(0, map.height() - 1);
+			uniform_int_distribution<int> offset(-static_cast<int>(range), range);
+			auto passable = [&](const Cell& cell) { return base_costs[map.index(cell)] < Infinite_Cost; };
+			Lot<pair<Cell, Cell>> pairs;
+			while (pairs.size() < count) {
+				unsigned start_column = column(random), start_row = row(random);
+				int goal_row = static_cast<int>(start_row) + offset(random);
+				if (goal_row < 0 or goal_row >= static_cast<int>(map.height())) continue;
+				Cell start = map.at(start_column, start_row);
+				Cell goal = map.at(hex::Map::wrap(static_cast<int>(start_column) + offset(random), map.width()), goal_row);
+				if (passable(start) and passable(goal)) pairs.emplace_back(start, goal);
+			}
+			return pairs;
+		}
+
+	};
+
+	// random A* queries and Dijkstra floods from several sources on a 1024x1024 map
+	void benchmark_pathfinding() {
+		Terrain terrain(1024, 1024);
+		Pathfinder pathfinder(terrain.map);
+		auto costs = terrain.costs();
+		Lot<Cell> path;
+		for (unsigned range : { 32u, 128u, 512u }) {
+			auto queries = terrain.queries(range < 512 ? 200 : 20, range, 7);
+			size_t found = 0;
+			auto search = [&] {
+				found = 0;
+				for (auto& query : queries) found += pathfinder.find_path(query.first, query.second, path, costs, 1.0f);
+			};
+			// the buffers have grown during the first search, the path is reused
+			search();
+			size_t allocations = benchmarking::allocations();
+			search();
+			double per_query = static_cast<double>(benchmarking::allocations() - allocations) / queries.size();
+			double seconds = benchmarking::measure(search, 3);
+			auto name = stringify("A* 1024x1024 within ", range);
+			benchmarking::report(name, seconds / queries.size() * 1e3, "ms per query");
+			benchmarking::report(name + " allocations", per_query, "per query");
+			benchmarking::report(name + " found", 100.0 * found / queries.size(), "%");
+		}
+		mt19937 random(7);
+		uniform_int_distribution<unsigned> column(0, 1023), row(0, 1023);
+		Lot<Cell> sources;
+		for (unsigned source = 0; source < 8; source++) sources.push_back(terrain.map.at(column(random), row(random)));
+		double seconds = benchmarking::measure([&] { pathfinder.flood(sources, costs, 100.0f); }, 5);
+		benchmarking::report("Dijkstra 1024x1024 from 8 sources up to cost 100", seconds * 1e3, "ms");
+	}
+
+	// hierarchical queries compared with A* on a map with two million cells
+	void benchmark_hierarchical_pathfinding() {
+		Terrain terrain(2048, 1024);
+		auto costs = terrain.costs();
+		HierarchicalPathfinder<TerrainCosts> hierarchical(terrain.map, costs, 1.0f);
+		Pathfinder flat(terrain.map);
+		auto build = benchmarking::measure([&] {
+			hierarchical.invalidate();
+			hierarchical.entrances();
+		}, 1);
+		benchmarking::report("HPA* 2048x1024 building the abstract graph", build * 1e3, "ms");
+		auto queries = terrain.queries(20, 1000, 11);
+		Lot<Cell> path;
+		double flat_cost = 0.0, hierarchical_cost = 0.0;
+		auto length = [&](const Lot<Cell>& path) {
+			float sum = 0.0f;
+			for (size_t step = 1; step < path.size(); step++) sum += costs(path[step - 1], path[step]);
+			return sum;
+		};
+		double seconds = benchmarking::measure([&] {
+			flat_cost = 0.0;
+			for (auto& query : queries) {
+				if (flat.find_path(query.first, query.second, path, costs, 1.0f)) flat_cost += length(path);
+			}
+		}, 1);
+		benchmarking::report("A* 2048x1024 within 1000", seconds / queries.size() * 1e3, "ms per query");
+		seconds = benchmarking::measure([&] {
+			for (auto& query : queries) hierarchical.find_waypoints(query.first, query.second, path);
+		}, 5);
+		benchmarking::report("HPA* 2048x1024 within 1000, abstract path", seconds / queries.size() * 1e3, "ms per query");
+		seconds = benchmarking::measure([&] {
+			hierarchical_cost = 0.0;
+			for (auto& query : queries) {
+				if (hierarchical.find_path(query.first, query.second, path)) hierarchical_cost += length(path);
+			}
+		}, 3);
+		benchmarking::report("HPA* 2048x1024 within 1000, refined path", seconds / queries.size() * 1e3, "ms per query");
+		benchmarking::report("HPA* 2048x1024 within 1000, cost above A*", 100.0 * (hierarchical_cost / flat_cost - 1.0), "%");
+		// an edit rebuilds the cluster of the cell and its neighbors on the next query
+		Cell edited = terrain.map.at(1000, 500);
+		seconds = benchmarking::measure([&] {
+			hierarchical.invalidate(edited);
+			hierarchical.find_waypoints(queries[0].first, queries[0].second, path);
+		}, 5);
+		benchmarking::report("HPA* 2048x1024 query after an edit", seconds * 1e3, "ms");
+	}
+
+	benchmarking::Registration pathfinding("Pathfinding", benchmark_pathfinding);
+	benchmarking::Registration hierarchical_pathfinding("HierarchicalPathfinding", benchmark_hierarchical_pathfinding);
+
+}
@@ -0,0 +1,98 @@
+#include <random>
+
+#include <hexagonal/Ranges.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	const unsigned Queries = 10000;
+
+	// time and allocations per query of the lazy ranges compared with the lots of Coordinates, which are collected from them
+	template<class Query>
+	void compare(const string& name, Query query) {
+		size_t allocations = benchmarking::allocations();
+		query();
+		double per_query = static_cast<double>(benchmarking::allocations() - allocations) / Queries;
+		benchmarking::report(name + " allocations", per_query, "per query");
+		benchmarking::report(name, benchmarking::measure(query) / Queries * 1e9, "ns per query");
+	}
+
+	// lines of up to 40 cells, like the rays picking a tile, which usually stop after a few cells
+	void benchmark_ranges() {
+		mt19937 random(7);
+		uniform_int_distribution<int> offset(-20, 20);
+		Lot<pair<Coordinates, Coordinates>> lines;
+		for (unsigned query = 0; query < Queries; query++) {
+			Coordinates begin(offset(random), offset(random));
+			lines.emplace_back(begin, Coordinates(begin.u + offset(random), begin.v + offset(random)));
+		}
+		int sum = 0;
+		compare("Line lot", [&] {
+			for (auto& line : lines) {
+				for (auto& coordinates : Coordinates::line(line.first, line.second, true)) sum += coordinates.u;
+			}
+		});
+		compare("Line range", [&] {
+			for (auto& line : lines) {
+				for (auto& coordinates : line_range(line.first, line.second, true)) sum += coordinates.u;
+			}
+		});
+		compare("Line lot stopping after 4 cells", [&] {
+			for (auto& line : lines) {
+				unsigned cells = 0;
+				for (auto& coordinates : Coordinates::line(line.first, line.second, true)) {
+					sum += coordinates.u;
+					if (++cells == 4) break;
+				}
+			}
+		});
+		compare("Line range stopping after 4 cells", [&] {
+			for (auto& line : lines) {
+				unsigned cells = 0;
+				for (auto& coordinates : line_range(line.first, line.second, true)) {
+					sum += coordinates.u;
+					if (++cells == 4) break;
+				}
+			}
+		});
+		compare("Ring lot (radius 8)", [&] {
+			for (unsigned query = 0; query < Queries; query++) {
+				for (auto& coordinates : Coordinates::ring(8, lines[query].first)) sum += coordinates.v;
+			}
+		});
+		compare("Ring range (radius 8)", [&] {
+			for (unsigned query = 0; query < Queries; query++) {
+				for (auto& coordinates : ring_range(8, lines[query].first)) sum += coordinates.v;
+			}
+		});
+		compare("Spiral lot (radius 8)", [&] {
+			for (unsigned query = 0; query < Queries; query++) {
+				for (auto& coordinates : Coordinates::spiral(8, lines[query].first)) sum += coordinates.v;
+			}
+		});
+		compare("Spiral range (radius 8)", [&] {
+			for (unsigned query = 0; query < Queries; query++) {
+				for (auto& coordinates : spiral_range(8, lines[query].first)) sum += coordinates.v;
+			}
+		});
+		compare("Rectangle lot (16x9)", [&] {
+			for (unsigned query = 0; query < Queries; query++) {
+				for (auto& coordinates : Coordinates::rectangle(16, 9, lines[query].first)) sum += coordinates.v;
+			}
+		});
+		compare("Rectangle range (16x9)", [&] {
+			for (unsigned query = 0; query < Queries; query++) {
+				for (auto& coordinates : rectangle_range(16, 9, lines[query].first)) sum += coordinates.v;
+			}
+		});
+		benchmarking::consume(sum);
+	}
+
+	benchmarking::Registration ranges("Ranges", benchmark_ranges);
+
+}
@@ -0,0 +1,70 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <cinder/utilities/SimplexBatch.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+
+namespace {
+
+	const size_t Points = 1 << 18;
+
+	// points per second of the scalar generator and of the batch kernels of every instruction set supported by the CPU
+	// the deviation of each kernel from the scalar generator is reported as well
+	void benchmark_simplex() {
+		Simplex::Generator generator(7);
+		vector<float> x(Points), y(Points), z(Points), result(Points), reference(Points);
+		mt19937 random(7);
+		uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+		for (size_t point = 0; point < Points; point++) {
+			x[point] = coordinate(random);
+			y[point] = coordinate(random);
+			z[point] = coordinate(random);
+		}
+		double megapoints = Points / 1e6;
+		auto deviation = [&] {
+			float largest = 0.0f;
+			for (size_t point = 0; point < Points; point++) largest = max(largest, abs(result[point] - reference[point]));
+			return largest;
+		};
+
+		struct Function {
+			const char* name;
+			function<void()> scalar;
+			function<void(const Simplex::Batch&)> batch;
+		};
+		Function functions[] = {
+			{ "2D noise",
+				[&] { for (size_t point = 0; point < Points; point++) reference[point] = generator.noise(glm::vec2(x[point], y[point])); },
+				[&](const Simplex::Batch& batch) { batch.noise(x.data(), y.data(), result.data(), Points); } },
+			{ "3D noise",
+				[&] { for (size_t point = 0; point < Points; point++) reference[point] = generator.noise(glm::vec3(x[point], y[point], z[point])); },
+				[&](const Simplex::Batch& batch) { batch.noise(x.data(), y.data(), z.data(), result.data(), Points); } },
+			{ "2D fBm (4 octaves)",
+				[&] { for (size_t point = 0; point < Points; point++) reference[point] = generator.fBm(glm::vec2(x[point], y[point])); },
+				[&](const Simplex::Batch& batch) { batch.fBm(x.data(), y.data(), result.data(), Points); } },
+			{ "3D ridged (4 octaves)",
+				[&] { for (size_t point = 0; point < Points; point++) reference[point] = generator.ridgedMF(glm::vec3(x[point], y[point], z[point])); },
+				[&](const Simplex::Batch& batch) { batch.ridgedMF(x.data(), y.data(), z.data(), result.data(), Points); } },
+		};
+		for (auto& function : functions) {
+			double seconds = benchmarking::measure(function.scalar, 5);
+			benchmarking::report(string("Simplex ") + function.name + " scalar generator", megapoints / seconds, "Mpoints/s");
+			Simplex::Batch batch(generator);
+			for (auto instruction_set : { Simplex::InstructionSet::Scalar, Simplex::InstructionSet::SSE41, Simplex::InstructionSet::AVX2 }) {
+				if (instruction_set > Simplex::Batch::supported_instruction_set()) continue;
+				batch.use(instruction_set);
+				seconds = benchmarking::measure([&] { function.batch(batch); }, 5);
+				auto name = string("Simplex ") + function.name + " batch " + Simplex::name(instruction_set);
+				benchmarking::report(name, megapoints / seconds, "Mpoints/s");
+				benchmarking::report(name + " deviation", deviation() * 1e6, "e-6");
+			}
+		}
+	}
+
+	benchmarking::Registration simplex("Simplex", benchmark_simplex);
+
+}
@@ -0,0 +1,80 @@
+#include <cmath>
+#include <random>
+
+#include <hexagonal/Visibility.h>
+
+#include "Benchmark.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	// fields of view of 500 viewers with a radius of 20 on a 1024x1024 map of hills
+	void benchmark_visibility() {
+		const unsigned Viewers = 500, Radius = 20;
+		hex::Map map(1024, 1024, false);
+		Lot<float> heights(map.width() * map.height());
+		for (unsigned row = 0; row < map.height(); row++) {
+			for (unsigned column = 0; column < map.width(); column++) {
+				heights[column + row * map.width()] = 3.0f * sin(column * 0.09f) * sin(row * 0.07f) + sin(column * 0.31f + row * 0.23f);
+			}
+		}
+		TerrainElevations elevations(map, heights.data());
+		mt19937 random(7);
+		uniform_int_distribution<unsigned> column(0, map.width() - 1), row(0, map.height() - 1);
+		Lot<Cell> viewers;
+		for (unsigned viewer = 0; viewer < Viewers; viewer++) viewers.push_back(map.at(column(random), row(random)));
+		FieldOfView field_of_view(map, Radius);
+
+		Lot<Cell> visible;
+		visible.reserve(3 * Radius * (Radius + 1) + 1);
+		size_t cells = 0;
+		auto compute = [&] {
+			cells = 0;
+			for (auto& viewer : viewers) {
+				field_of_view.compute(viewer, Radius, 1.0f, elevations, visible);
+				cells += visible.size();
+			}
+		};
+		compute();
+		size_t allocations = benchmarking::allocations();
+		compute();
+		benchmarking::report("Field of view compute allocations", static_cast<double>(benchmarking::allocations() - allocations) / Viewers, "per viewer");
+		double seconds = benchmarking::measure(compute);
+		benchmarking::report("Field of view compute", seconds / Viewers * 1e6, "us per viewer");
+		benchmarking::report("Field of view visible", 100.0 * cells / Viewers / (3 * Radius * (Radius + 1) + 1), "% of the cells");
+
+		// every viewer moves by one cell and the changes against its previous field of view are determined
+		Lot<Lot<Cell>> previous(Viewers);
+		for (unsigned viewer = 0; viewer < Viewers; viewer++) {
+			field_of_view.compute(viewers[viewer], Radius, 1.0f, elevations, previous[viewer]);
+			previous[viewer].reserve(3 * Radius * (Radius + 1) + 1);
+		}
+		Lot<Cell> entered, left;
+		entered.reserve(previous[0].capacity());
+		left.reserve(previous[0].capacity());
+		size_t changes = 0;
+		unsigned step = 0;
+		auto recompute = [&] {
+			changes = 0;
+			for (unsigned viewer = 0; viewer < Viewers; viewer++) {
+				viewers[viewer] += static_cast<Direction>(step % 6);
+				field_of_view.recompute(viewers[viewer], Radius, 1.0f, elevations, previous[viewer], entered, left);
+				changes += entered.size() + left.size();
+			}
+			step++;
+		};
+		seconds = benchmarking::measure(recompute);
+		benchmarking::report("Field of view recompute after a move", seconds / Viewers * 1e6, "us per viewer");
+		benchmarking::report("Field of view changes after a move", static_cast<double>(changes) / Viewers, "cells per viewer");
+
+		Lot<uint16> counts(map.width() * map.height());
+		seconds = benchmarking::measure([&] { field_of_view.reveal(viewers, Radius, 1.0f, elevations, counts); });
+		benchmarking::report("Field of view reveal of 500 viewers", seconds * 1e3, "ms");
+	}
+
+	benchmarking::Registration visibility("Visibility", benchmark_visibility);
+
+}
@@ -0,0 +1,585 @@
+#include "SimplexBatch.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SIMPLEX_BATCH_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace Simplex {
+
+	namespace {
+
+		// points of one octave which are evaluated at once by the fractal sums
+		const std::size_t Chunk_Size = 256;
+
+		// skewing factors of Generator::noise in single precision
+		const float F2f = 0.366025403f;
+		const float G2f = 0.211324865f;
+		const float F3f = 0.333333333f;
+		const float G3f = 0.166666667f;
+
+	}
+
+#ifdef SIMPLEX_BATCH_X86
+
+#if defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.1")
+#endif
+
+	namespace sse41 {
+
+		using Floats = __m128;
+		using Integers = __m128i;
+
+		const std::size_t Width = 4;
+
+		// emulates FASTFLOOR of the scalar noise, which rounds down by one for non-positive integers
+		inline Integers fast_floor(Floats x) {
+			Integers truncated = _mm_cvttps_epi32(x);
+			Integers positive = _mm_castps_si128(_mm_cmpgt_ps(x, _mm_setzero_ps()));
+			return _mm_sub_epi32(_mm_sub_epi32(truncated, _mm_set1_epi32(1)), positive);
+		}
+
+		inline Integers gather(const int32_t* table, Integers index) {
+			return _mm_setr_epi32(table[_mm_extract_epi32(index, 0)], table[_mm_extract_epi32(index, 1)], table[_mm_extract_epi32(index, 2)], table[_mm_extract_epi32(index, 3)]);
+		}
+
+		// flips the sign of "value" where "bit" of "hash" is set
+		template <int Bit>
+		inline Floats flip(Floats value, Integers hash) {
+			return _mm_xor_ps(value, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(hash, _mm_set1_epi32(1 << Bit)), 31 - Bit)));
+		}
+
+		// selects "one" where "mask" is set and zero otherwise
+		inline Floats select(Floats mask, float one) {
+			return _mm_and_ps(mask, _mm_set1_ps(one));
+		}
+
+		inline Integers select(Integers mask, int one) {
+			return _mm_and_si128(mask, _mm_set1_epi32(one));
+		}
+
+		inline Floats falloff(Floats t) {
+			t = _mm_max_ps(t, _mm_setzero_ps());
+			t = _mm_mul_ps(t, t);
+			return _mm_mul_ps(t, t);
+		}
+
+		inline Floats grad(Integers hash, Floats x, Floats y) {
+			Integers h = _mm_and_si128(hash, _mm_set1_epi32(7));
+			Floats swap = _mm_castsi128_ps(_mm_cmpgt_epi32(h, _mm_set1_epi32(3)));
+			Floats u = _mm_blendv_ps(x, y, swap);
+			Floats v = _mm_blendv_ps(y, x, swap);
+			return _mm_add_ps(flip<0>(u, h), flip<1>(_mm_add_ps(v, v), h));
+		}
+
+		inline Floats grad(Integers hash, Floats x, Floats y, Floats z) {
+			Integers h = _mm_and_si128(hash, _mm_set1_epi32(15));
+			Floats u = _mm_blendv_ps(x, y, _mm_castsi128_ps(_mm_cmpgt_epi32(h, _mm_set1_epi32(7))));
+			Floats repeat = _mm_castsi128_ps(_mm_or_si128(_mm_cmpeq_epi32(h, _mm_set1_epi32(12)), _mm_cmpeq_epi32(h, _mm_set1_epi32(14))));
+			Floats v = _mm_blendv_ps(z, x, repeat);
+			v = _mm_blendv_ps(v, y, _mm_castsi128_ps(_mm_cmplt_epi32(h, _mm_set1_epi32(4))));
+			return _mm_add_ps(flip<0>(u, h), flip<1>(v, h));
+		}
+
+		inline Floats noise(const int32_t* perm, Floats x, Floats y) {
+			Floats s = _mm_mul_ps(_mm_add_ps(x, y), _mm_set1_ps(F2f));
+			Integers i = fast_floor(_mm_add_ps(x, s));
+			Integers j = fast_floor(_mm_add_ps(y, s));
+			Floats t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(i, j)), _mm_set1_ps(G2f));
+			Floats x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+			Floats y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+
+			Floats lower = _mm_cmpgt_ps(x0, y0);
+			Floats g2 = _mm_set1_ps(G2f);
+			Floats x1 = _mm_add_ps(_mm_sub_ps(x0, select(lower, 1.0f)), g2);
+			Floats y1 = _mm_add_ps(_mm_sub_ps(y0, _mm_andnot_ps(lower, _mm_set1_ps(1.0f))), g2);
+			Floats x2 = _mm_add_ps(_mm_sub_ps(x0, _mm_set1_ps(1.0f)), _mm_set1_ps(2.0f * G2f));
+			Floats y2 = _mm_add_ps(_mm_sub_ps(y0, _mm_set1_ps(1.0f)), _mm_set1_ps(2.0f * G2f));
+
+			Integers one = _mm_set1_epi32(1);
+			Integers i1 = select(_mm_castps_si128(lower), 1);
+			Integers j1 = _mm_sub_epi32(one, i1);
+			Integers ii = _mm_and_si128(i, _mm_set1_epi32(0xff));
+			Integers jj = _mm_and_si128(j, _mm_set1_epi32(0xff));
+			Integers h0 = gather(perm, _mm_add_epi32(ii, gather(perm, jj)));
+			Integers h1 = gather(perm, _mm_add_epi32(_mm_add_epi32(ii, i1), gather(perm, _mm_add_epi32(jj, j1))));
+			Integers h2 = gather(perm, _mm_add_epi32(_mm_add_epi32(ii, one), gather(perm, _mm_add_epi32(jj, one))));
+
+			Floats half = _mm_set1_ps(0.5f);
+			Floats n0 = _mm_mul_ps(falloff(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x0, x0)), _mm_mul_ps(y0, y0))), grad(h0, x0, y0));
+			Floats n1 = _mm_mul_ps(falloff(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x1, x1)), _mm_mul_ps(y1, y1))), grad(h1, x1, y1));
+			Floats n2 = _mm_mul_ps(falloff(_mm_sub_ps(_mm_sub_ps(half, _mm_mul_ps(x2, x2)), _mm_mul_ps(y2, y2))), grad(h2, x2, y2));
+			return _mm_mul_ps(_mm_set1_ps(45.0f), _mm_add_ps(_mm_add_ps(n0, n1), n2));
+		}
+
+		inline Floats corner(const int32_t* perm, Integers ii, Integers jj, Integers kk, Integers di, Integers dj, Integers dk, Floats x, Floats y, Floats z) {
+			Integers hash = gather(perm, _mm_add_epi32(_mm_add_epi32(ii, di), gather(perm, _mm_add_epi32(_mm_add_epi32(jj, dj), gather(perm, _mm_add_epi32(kk, dk))))));
+			Floats t = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_set1_ps(0.6f), _mm_mul_ps(x, x)), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+			return _mm_mul_ps(falloff(t), grad(hash, x, y, z));
+		}
+
+		inline Floats noise(const int32_t* perm, Floats x, Floats y, Floats z) {
+			Floats s = _mm_mul_ps(_mm_add_ps(_mm_add_ps(x, y), z), _mm_set1_ps(F3f));
+			Integers i = fast_floor(_mm_add_ps(x, s));
+			Integers j = fast_floor(_mm_add_ps(y, s));
+			Integers k = fast_floor(_mm_add_ps(z, s));
+			Floats t = _mm_mul_ps(_mm_cvtepi32_ps(_mm_add_epi32(_mm_add_epi32(i, j), k)), _mm_set1_ps(G3f));
+			Floats x0 = _mm_sub_ps(x, _mm_sub_ps(_mm_cvtepi32_ps(i), t));
+			Floats y0 = _mm_sub_ps(y, _mm_sub_ps(_mm_cvtepi32_ps(j), t));
+			Floats z0 = _mm_sub_ps(z, _mm_sub_ps(_mm_cvtepi32_ps(k), t));
+
+			// offsets of the second and third corner, which follow the branches of the scalar noise
+			Floats all = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			Floats xy = _mm_cmpge_ps(x0, y0);
+			Floats yz = _mm_cmpge_ps(y0, z0);
+			Floats xz = _mm_cmpge_ps(x0, z0);
+			Floats i1 = _mm_and_ps(xy, _mm_or_ps(yz, xz));
+			Floats j1 = _mm_andnot_ps(xy, yz);
+			Floats k1 = _mm_andnot_ps(_mm_or_ps(i1, j1), all);
+			Floats i2 = _mm_or_ps(xy, _mm_and_ps(yz, xz));
+			Floats j2 = _mm_or_ps(_mm_andnot_ps(xy, all), yz);
+			Floats k2 = _mm_or_ps(_mm_andnot_ps(yz, all), _mm_andnot_ps(_mm_or_ps(xy, xz), all));
+
+			Floats g3 = _mm_set1_ps(G3f);
+			Floats g3_2 = _mm_set1_ps(2.0f * G3f);
+			Floats g3_3 = _mm_set1_ps(3.0f * G3f);
+			Floats x1 = _mm_add_ps(_mm_sub_ps(x0, select(i1, 1.0f)), g3);
+			Floats y1 = _mm_add_ps(_mm_sub_ps(y0, select(j1, 1.0f)), g3);
+			Floats z1 = _mm_add_ps(_mm_sub_ps(z0, select(k1, 1.0f)), g3);
+			Floats x2 = _mm_add_ps(_mm_sub_ps(x0, select(i2, 1.0f)), g3_2);
+			Floats y2 = _mm_add_ps(_mm_sub_ps(y0, select(j2, 1.0f)), g3_2);
+			Floats z2 = _mm_add_ps(_mm_sub_ps(z0, select(k2, 1.0f)), g3_2);
+			Floats x3 = _mm_add_ps(_mm_sub_ps(x0, _mm_set1_ps(1.0f)), g3_3);
+			Floats y3 = _mm_add_ps(_mm_sub_ps(y0, _mm_set1_ps(1.0f)), g3_3);
+			Floats z3 = _mm_add_ps(_mm_sub_ps(z0, _mm_set1_ps(1.0f)), g3_3);
+
+			Integers zero = _mm_setzero_si128();
+			Integers one = _mm_set1_epi32(1);
+			Integers ii = _mm_and_si128(i, _mm_set1_epi32(0xff));
+			Integers jj = _mm_and_si128(j, _mm_set1_epi32(0xff));
+			Integers kk = _mm_and_si128(k, _mm_set1_epi32(0xff));
+			Floats n0 = corner(perm, ii, jj, kk, zero, zero, zero, x0, y0, z0);
+			Floats n1 = corner(perm, ii, jj, kk, select(_mm_castps_si128(i1), 1), select(_mm_castps_si128(j1), 1), select(_mm_castps_si128(k1), 1), x1, y1, z1);
+			Floats n2 = corner(perm, ii, jj, kk, select(_mm_castps_si128(i2), 1), select(_mm_castps_si128(j2), 1), select(_mm_castps_si128(k2), 1), x2, y2, z2);
+			Floats n3 = corner(perm, ii, jj, kk, one, one, one, x3, y3, z3);
+			return _mm_mul_ps(_mm_set1_ps(32.7f), _mm_add_ps(_mm_add_ps(n0, n1), _mm_add_ps(n2, n3)));
+		}
+
+		void evaluate(const int32_t* perm, unsigned dimensions, const float* const* coordinates, float* result, std::size_t count) {
+			std::size_t index = 0;
+			float padded[3][Width] = {};
+			float rest[Width];
+			for (; index < count; index += Width) {
+				const float* x = coordinates[0] + index;
+				const float* y = coordinates[1] + index;
+				const float* z = dimensions == 3 ? coordinates[2] + index : nullptr;
+				bool partial = count - index < Width;
+				if (partial) {
+					for (unsigned dimension = 0; dimension < dimensions; dimension++) {
+						std::copy(coordinates[dimension] + index, coordinates[dimension] + count, padded[dimension]);
+					}
+					x = padded[0];
+					y = padded[1];
+					z = padded[2];
+				}
+				Floats values = dimensions == 3 ? noise(perm, _mm_loadu_ps(x), _mm_loadu_ps(y), _mm_loadu_ps(z)) : noise(perm, _mm_loadu_ps(x), _mm_loadu_ps(y));
+				if (partial) {
+					_mm_storeu_ps(rest, values);
+					std::copy(rest, rest + (count - index), result + index);
+				} else {
+					_mm_storeu_ps(result + index, values);
+				}
+			}
+		}
+
+	}
+
+#if defined(__GNUC__)
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+	namespace avx2 {
+
+		using Floats = __m256;
+		using Integers = __m256i;
+
+		const std::size_t Width = 8;
+
+		// emulates FASTFLOOR of the scalar noise, which rounds down by one for non-positive integers
+		inline Integers fast_floor(Floats x) {
+			Integers truncated = _mm256_cvttps_epi32(x);
+			Integers positive = _mm256_castps_si256(_mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ));
+			return _mm256_sub_epi32(_mm256_sub_epi32(truncated, _mm256_set1_epi32(1)), positive);
+		}
+
+		inline Integers gather(const int32_t* table, Integers index) {
+			return _mm256_i32gather_epi32(reinterpret_cast<const int*>(table), index, 4);
+		}
+
+		// flips the sign of "value" where "bit" of "hash" is set
+		template <int Bit>
+		inline Floats flip(Floats value, Integers hash) {
+			return _mm256_xor_ps(value, _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(hash, _mm256_set1_epi32(1 << Bit)), 31 - Bit)));
+		}
+
+		// selects "one" where "mask" is set and zero otherwise
+		inline Floats select(Floats mask, float one) {
+			return _mm256_and_ps(mask, _mm256_set1_ps(one));
+		}
+
+		inline Integers select(Integers mask, int one) {
+			return _mm256_and_si256(mask, _mm256_set1_epi32(one));
+		}
+
+		inline Floats falloff(Floats t) {
+			t = _mm256_max_ps(t, _mm256_setzero_ps());
+			t = _mm256_mul_ps(t, t);
+			return _mm256_mul_ps(t, t);
+		}
+
+		inline Floats grad(Integers hash, Floats x, Floats y) {
+			Integers h = _mm256_and_si256(hash, _mm256_set1_epi32(7));
+			Floats swap = _mm256_castsi256_ps(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(3)));
+			Floats u = _mm256_blendv_ps(x, y, swap);
+			Floats v = _mm256_blendv_ps(y, x, swap);
+			return _mm256_add_ps(flip<0>(u, h), flip<1>(_mm256_add_ps(v, v), h));
+		}
+
+		inline Floats grad(Integers hash, Floats x, Floats y, Floats z) {
+			Integers h = _mm256_and_si256(hash, _mm256_set1_epi32(15));
+			Floats u = _mm256_blendv_ps(x, y, _mm256_castsi256_ps(_mm256_cmpgt_epi32(h, _mm256_set1_epi32(7))));
+			Floats repeat = _mm256_castsi256_ps(_mm256_or_si256(_mm256_cmpeq_epi32(h, _mm256_set1_epi32(12)), _mm256_cmpeq_epi32(h, _mm256_set1_epi32(14))));
+			Floats v = _mm256_blendv_ps(z, x, repeat);
+			v = _mm256_blendv_ps(v, y, _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(4), h)));
+			return _mm256_add_ps(flip<0>(u, h), flip<1>(v, h));
+		}
+
+		inline Floats noise(const int32_t* perm, Floats x, Floats y) {
+			Floats s = _mm256_mul_ps(_mm256_add_ps(x, y), _mm256_set1_ps(F2f));
+			Integers i = fast_floor(_mm256_add_ps(x, s));
+			Integers j = fast_floor(_mm256_add_ps(y, s));
+			Floats t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(i, j)), _mm256_set1_ps(G2f));
+			Floats x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+			Floats y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+
+			Floats lower = _mm256_cmp_ps(x0, y0, _CMP_GT_OQ);
+			Floats g2 = _mm256_set1_ps(G2f);
+			Floats x1 = _mm256_add_ps(_mm256_sub_ps(x0, select(lower, 1.0f)), g2);
+			Floats y1 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_andnot_ps(lower, _mm256_set1_ps(1.0f))), g2);
+			Floats x2 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_set1_ps(1.0f)), _mm256_set1_ps(2.0f * G2f));
+			Floats y2 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_set1_ps(1.0f)), _mm256_set1_ps(2.0f * G2f));
+
+			Integers one = _mm256_set1_epi32(1);
+			Integers i1 = select(_mm256_castps_si256(lower), 1);
+			Integers j1 = _mm256_sub_epi32(one, i1);
+			Integers ii = _mm256_and_si256(i, _mm256_set1_epi32(0xff));
+			Integers jj = _mm256_and_si256(j, _mm256_set1_epi32(0xff));
+			Integers h0 = gather(perm, _mm256_add_epi32(ii, gather(perm, jj)));
+			Integers h1 = gather(perm, _mm256_add_epi32(_mm256_add_epi32(ii, i1), gather(perm, _mm256_add_epi32(jj, j1))));
+			Integers h2 = gather(perm, _mm256_add_epi32(_mm256_add_epi32(ii, one), gather(perm, _mm256_add_epi32(jj, one))));
+
+			Floats half = _mm256_set1_ps(0.5f);
+			Floats n0 = _mm256_mul_ps(falloff(_mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x0, x0)), _mm256_mul_ps(y0, y0))), grad(h0, x0, y0));
+			Floats n1 = _mm256_mul_ps(falloff(_mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x1, x1)), _mm256_mul_ps(y1, y1))), grad(h1, x1, y1));
+			Floats n2 = _mm256_mul_ps(falloff(_mm256_sub_ps(_mm256_sub_ps(half, _mm256_mul_ps(x2, x2)), _mm256_mul_ps(y2, y2))), grad(h2, x2, y2));
+			return _mm256_mul_ps(_mm256_set1_ps(45.0f), _mm256_add_ps(_mm256_add_ps(n0, n1), n2));
+		}
+
+		inline Floats corner(const int32_t* perm, Integers ii, Integers jj, Integers kk, Integers di, Integers dj, Integers dk, Floats x, Floats y, Floats z) {
+			Integers hash = gather(perm, _mm256_add_epi32(_mm256_add_epi32(ii, di), gather(perm, _mm256_add_epi32(_mm256_add_epi32(jj, dj), gather(perm, _mm256_add_epi32(kk, dk))))));
+			Floats t = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(0.6f), _mm256_mul_ps(x, x)), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+			return _mm256_mul_ps(falloff(t), grad(hash, x, y, z));
+		}
+
+		inline Floats noise(const int32_t* perm, Floats x, Floats y, Floats z) {
+			Floats s = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(x, y), z), _mm256_set1_ps(F3f));
+			Integers i = fast_floor(_mm256_add_ps(x, s));
+			Integers j = fast_floor(_mm256_add_ps(y, s));
+			Integers k = fast_floor(_mm256_add_ps(z, s));
+			Floats t = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_add_epi32(i, j), k)), _mm256_set1_ps(G3f));
+			Floats x0 = _mm256_sub_ps(x, _mm256_sub_ps(_mm256_cvtepi32_ps(i), t));
+			Floats y0 = _mm256_sub_ps(y, _mm256_sub_ps(_mm256_cvtepi32_ps(j), t));
+			Floats z0 = _mm256_sub_ps(z, _mm256_sub_ps(_mm256_cvtepi32_ps(k), t));
+
+			// offsets of the second and third corner, which follow the branches of the scalar noise
+			Floats all = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			Floats xy = _mm256_cmp_ps(x0, y0, _CMP_GE_OQ);
+			Floats yz = _mm256_cmp_ps(y0, z0, _CMP_GE_OQ);
+			Floats xz = _mm256_cmp_ps(x0, z0, _CMP_GE_OQ);
+			Floats i1 = _mm256_and_ps(xy, _mm256_or_ps(yz, xz));
+			Floats j1 = _mm256_andnot_ps(xy, yz);
+			Floats k1 = _mm256_andnot_ps(_mm256_or_ps(i1, j1), all);
+			Floats i2 = _mm256_or_ps(xy, _mm256_and_ps(yz, xz));
+			Floats j2 = _mm256_or_ps(_mm256_andnot_ps(xy, all), yz);
+			Floats k2 = _mm256_or_ps(_mm256_andnot_ps(yz, all), _mm256_andnot_ps(_mm256_or_ps(xy, xz), all));
+
+			Floats g3 = _mm256_set1_ps(G3f);
+			Floats g3_2 = _mm256_set1_ps(2.0f * G3f);
+			Floats g3_3 = _mm256_set1_ps(3.0f * G3f);
+			Floats x1 = _mm256_add_ps(_mm256_sub_ps(x0, select(i1, 1.0f)), g3);
+			Floats y1 = _mm256_add_ps(_mm256_sub_ps(y0, select(j1, 1.0f)), g3);
+			Floats z1 = _mm256_add_ps(_mm256_sub_ps(z0, select(k1, 1.0f)), g3);
+			Floats x2 = _mm256_add_ps(_mm256_sub_ps(x0, select(i2, 1.0f)), g3_2);
+			Floats y2 = _mm256_add_ps(_mm256_sub_ps(y0, select(j2, 1.0f)), g3_2);
+			Floats z2 = _mm256_add_ps(_mm256_sub_ps(z0, select(k2, 1.0f)), g3_2);
+			Floats x3 = _mm256_add_ps(_mm256_sub_ps(x0, _mm256_set1_ps(1.0f)), g3_3);
+			Floats y3 = _mm256_add_ps(_mm256_sub_ps(y0, _mm256_set1_ps(1.0f)), g3_3);
+			Floats z3 = _mm256_add_ps(_mm256_sub_ps(z0, _mm256_set1_ps(1.0f)), g3_3);
+
+			Integers zero = _mm256_setzero_si256();
+			Integers one = _mm256_set1_epi32(1);
+			Integers ii = _mm256_and_si256(i, _mm256_set1_epi32(0xff));
+			Integers jj = _mm256_and_si256(j, _mm256_set1_epi32(0xff));
+			Integers kk = _mm256_and_si256(k, _mm256_set1_epi32(0xff));
+			Floats n0 = corner(perm, ii, jj, kk, zero, zero, zero, x0, y0, z0);
+			Floats n1 = corner(perm, ii, jj, kk, select(_mm256_castps_si256(i1), 1), select(_mm256_castps_si256(j1), 1), select(_mm256_castps_si256(k1), 1), x1, y1, z1);
+			Floats n2 = corner(perm, ii, jj, kk, select(_mm256_castps_si256(i2), 1), select(_mm256_castps_si256(j2), 1), select(_mm256_castps_si256(k2), 1), x2, y2, z2);
+			Floats n3 = corner(perm, ii, jj, kk, one, one, one, x3, y3, z3);
+			return _mm256_mul_ps(_mm256_set1_ps(32.7f), _mm256_add_ps(_mm256_add_ps(n0, n1), _mm256_add_ps(n2, n3)));
+		}
+
+		void evaluate(const int32_t* perm, unsigned dimensions, const float* const* coordinates, float* result, std::size_t count) {
+			std::size_t index = 0;
+			float padded[3][Width] = {};
+			float rest[Width];
+			for (; index < count; index += Width) {
+				const float* x = coordinates[0] + index;
+				const float* y = coordinates[1] + index;
+				const float* z = dimensions == 3 ? coordinates[2] + index : nullptr;
+				bool partial = count - index < Width;
+				if (partial) {
+					for (unsigned dimension = 0; dimension < dimensions; dimension++) {
+						std::copy(coordinates[dimension] + index, coordinates[dimension] + count, padded[dimension]);
+					}
+					x = padded[0];
+					y = padded[1];
+					z = padded[2];
+				}
+				Floats values = dimensions == 3 ? noise(perm, _mm256_loadu_ps(x), _mm256_loadu_ps(y), _mm256_loadu_ps(z)) : noise(perm, _mm256_loadu_ps(x), _mm256_loadu_ps(y));
+				if (partial) {
+					_mm256_storeu_ps(rest, values);
+					std::copy(rest, rest + (count - index), result + index);
+				} else {
+					_mm256_storeu_ps(result + index, values);
+				}
+			}
+			// avoids the penalty of mixing AVX and legacy SSE instructions in the caller
+			_mm256_zeroupper();
+		}
+
+	}
+
+#if defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
+
+	const char* name(InstructionSet instruction_set) {
+		switch (instruction_set) {
+			case InstructionSet::SSE41: return "SSE4.1";
+			case InstructionSet::AVX2: return "AVX2";
+			default: return "Scalar";
+		}
+	}
+
+	InstructionSet Batch::supported_instruction_set() {
+	#ifdef SIMPLEX_BATCH_X86
+		static InstructionSet supported = []() {
+		#if defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			int identifiers = info[0];
+			__cpuid(info, 1);
+			bool sse41 = (info[2] & (1 << 19)) != 0;
+			// AVX registers have to be saved by the operating system
+			bool avx = (info[2] & (1 << 27)) != 0 and (info[2] & (1 << 28)) != 0 and (_xgetbv(0) & 6) == 6;
+			bool avx2 = false;
+			if (avx and identifiers >= 7) {
+				__cpuidex(info, 7, 0);
+				avx2 = (info[1] & (1 << 5)) != 0;
+			}
+		#else
+			__builtin_cpu_init();
+			bool sse41 = __builtin_cpu_supports("sse4.1");
+			bool avx2 = __builtin_cpu_supports("avx2");
+		#endif
+			if (avx2) return InstructionSet::AVX2;
+			if (sse41) return InstructionSet::SSE41;
+			return InstructionSet::Scalar;
+		}();
+		return supported;
+	#else
+		return InstructionSet::Scalar;
+	#endif
+	}
+
+	Batch::Batch(const Generator& generator) : generator(generator), selected(supported_instruction_set()) {
+		std::copy(generator.permutation(), generator.permutation() + 512, permutation);
+	}
+
+	void Batch::use(InstructionSet instruction_set) {
+		selected = std::min(instruction_set, supported_instruction_set());
+	}
+
+	void Batch::evaluate(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count) const {
+		switch (selected) {
+		#ifdef SIMPLEX_BATCH_X86
+			case InstructionSet::AVX2:
+				avx2::evaluate(permutation, dimensions, coordinates, result, count);
+				return;
+			case InstructionSet::SSE41:
+				sse41::evaluate(permutation, dimensions, coordinates, result, count);
+				return;
+		#endif
+			default:
+				if (dimensions == 3) {
+					for (std::size_t index = 0; index < count; index++) {
+						result[index] = generator.noise(glm::vec3(coordinates[0][index], coordinates[1][index], coordinates[2][index]));
+					}
+				} else {
+					for (std::size_t index = 0; index < count; index++) {
+						result[index] = generator.noise(glm::vec2(coordinates[0][index], coordinates[1][index]));
+					}
+				}
+		}
+	}
+
+	void Batch::noise(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count, const Options& options) const {
+		float scaled[3][Chunk_Size];
+		const float* octave_coordinates[3] = { scaled[0], scaled[1], scaled[2] };
+		float octave[Chunk_Size];
+		for (std::size_t first = 0; first < count; first += Chunk_Size) {
+			std::size_t size = std::min(Chunk_Size, count - first);
+			float* sum = result + first;
+			std::fill(sum, sum + size, 0.0f);
+			float frequency = options.frequency;
+			float range = 0.0f;
+			float octave_amplitude = 1.0f;
+			for (unsigned o = 1; o <= options.octaves; o++) {
+				for (unsigned dimension = 0; dimension < dimensions; dimension++) {
+					for (std::size_t index = 0; index < size; index++) scaled[dimension][index] = coordinates[dimension][first + index] * frequency;
+				}
+				evaluate(dimensions, octave_coordinates, octave, size);
+				for (std::size_t index = 0; index < size; index++) sum[index] += octave[index] * octave_amplitude;
+				range += octave_amplitude;
+				frequency *= options.lacunarity;
+				octave_amplitude *= options.persistence;
+			}
+			// same shaping as the scalar noise sum
+			for (std::size_t index = 0; index < size; index++) {
+				float value = sum[index] / range;
+				if (options.positive) value = to_unsigned(value);
+				if (options.power == 1.0f) {
+					sum[index] = value * options.amplitude;
+				} else if (not options.positive and value < 0.0f) {
+					sum[index] = -std::pow(-value, options.power) * options.amplitude;
+				} else {
+					sum[index] = std::pow(value, options.power) * options.amplitude;
+				}
+			}
+		}
+	}
+
+	void Batch::fBm(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count, uint8_t octaves, float lacunarity, float gain) const {
+		float scaled[3][Chunk_Size];
+		const float* octave_coordinates[3] = { scaled[0], scaled[1], scaled[2] };
+		float octave[Chunk_Size];
+		for (std::size_t first = 0; first < count; first += Chunk_Size) {
+			std::size_t size = std::min(Chunk_Size, count - first);
+			float* sum = result + first;
+			std::fill(sum, sum + size, 0.0f);
+			float freq = 1.0f;
+			float amp = 0.5f;
+			for (uint8_t i = 0; i < octaves; i++) {
+				for (unsigned dimension = 0; dimension < dimensions; dimension++) {
+					for (std::size_t index = 0; index < size; index++) scaled[dimension][index] = coordinates[dimension][first + index] * freq;
+				}
+				evaluate(dimensions, octave_coordinates, octave, size);
+				for (std::size_t index = 0; index < size; index++) sum[index] += octave[index] * amp;
+				freq *= lacunarity;
+				amp *= gain;
+			}
+		}
+	}
+
+	void Batch::ridgedMF(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count, float ridgeOffset, uint8_t octaves, float lacunarity, float gain) const {
+		float scaled[3][Chunk_Size];
+		const float* octave_coordinates[3] = { scaled[0], scaled[1], scaled[2] };
+		float octave[Chunk_Size];
+		float previous[Chunk_Size];
+		for (std::size_t first = 0; first < count; first += Chunk_Size) {
+			std::size_t size = std::min(Chunk_Size, count - first);
+			float* sum = result + first;
+			std::fill(sum, sum + size, 0.0f);
+			std::fill(previous, previous + size, 1.0f);
+			float freq = 1.0f;
+			float amp = 0.5f;
+			for (uint8_t i = 0; i < octaves; i++) {
+				for (unsigned dimension = 0; dimension < dimensions; dimension++) {
+					for (std::size_t index = 0; index < size; index++) scaled[dimension][index] = coordinates[dimension][first + index] * freq;
+				}
+				evaluate(dimensions, octave_coordinates, octave, size);
+				for (std::size_t index = 0; index < size; index++) {
+					float n = ridgeOffset - std::abs(octave[index]);
+					n *= n;
+					sum[index] += n * amp * previous[index];
+					previous[index] = n;
+				}
+				freq *= lacunarity;
+				amp *= gain;
+			}
+		}
+	}
+
+	void Batch::noise(const float* x, const float* y, float* result, std::size_t count) const {
+		const float* coordinates[] = { x, y };
+		evaluate(2, coordinates, result, count);
+	}
+
+	void Batch::noise(const float* x, const float* y, const float* z, float* result, std::size_t count) const {
+		const float* coordinates[] = { x, y, z };
+		evaluate(3, coordinates, result, count);
+	}
+
+	void Batch::noise(const float* x, const float* y, float* result, std::size_t count, const Options& options) const {
+		const float* coordinates[] = { x, y };
+		noise(2, coordinates, result, count, options);
+	}
+
+	void Batch::noise(const float* x, const float* y, const float* z, float* result, std::size_t count, const Options& options) const {
+		const float* coordinates[] = { x, y, z };
+		noise(3, coordinates, result, count, options);
+	}
+
+	void Batch::fBm(const float* x, const float* y, float* result, std::size_t count, uint8_t octaves, float lacunarity, float gain) const {
+		const float* coordinates[] = { x, y };
+		fBm(2, coordinates, result, count, octaves, lacunarity, gain);
+	}
+
+	void Batch::fBm(const float* x, const float* y, const float* z, float* result, std::size_t count, uint8_t octaves, float lacunarity, float gain) const {
+		const float* coordinates[] = { x, y, z };
+		fBm(3, coordinates, result, count, octaves, lacunarity, gain);
+	}
+
+	void Batch::ridgedMF(const float* x, const float* y, float* result, std::size_t count, float ridgeOffset, uint8_t octaves, float lacunarity, float gain) const {
+		const float* coordinates[] = { x, y };
+		ridgedMF(2, coordinates, result, count, ridgeOffset, octaves, lacunarity, gain);
+	}
+
+	void Batch::ridgedMF(const float* x, const float* y, const float* z, float* result, std::size_t count, float ridgeOffset, uint8_t octaves, float lacunarity, float gain) const {
+		const float* coordinates[] = { x, y, z };
+		ridgedMF(3, coordinates, result, count, ridgeOffset, octaves, lacunarity, gain);
+	}
+
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <cinder/utilities/Simplex.h>
+
+namespace Simplex {
+
+	// instruction sets of the batch kernels, ordered by their width
+	enum class InstructionSet { Scalar, SSE41, AVX2 };
+
+	// name of an instruction set, e.g. for logging
+	const char* name(InstructionSet instruction_set);
+
+	// Evaluates the simplex noise of a generator for many points at once with SIMD kernels (4 points with SSE4.1, 8 points with AVX2).
+	// Points are given as separate coordinate arrays, e.g. the positions of one row of a map.
+	// The kernel is selected at runtime by the features of the CPU, the results match the scalar functions of the generator up to rounding.
+	// Like the generator, a batch only reads its tables and can be used from multiple threads.
+	class Batch {
+
+		Generator generator;
+		int32_t permutation[512];
+		InstructionSet selected;
+
+		// evaluates plain noise of two or three dimensional points
+		void evaluate(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count) const;
+
+		void noise(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count, const Options& options) const;
+
+		void fBm(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count, uint8_t octaves, float lacunarity, float gain) const;
+
+		void ridgedMF(unsigned dimensions, const float* const* coordinates, float* result, std::size_t count, float ridgeOffset, uint8_t octaves, float lacunarity, float gain) const;
+
+	public:
+
+		// copies the permutation table of "generator" and selects the widest instruction set supported by the CPU
+		explicit Batch(const Generator& generator = Generator());
+
+		// widest instruction set supported by the CPU and the operating system
+		static InstructionSet supported_instruction_set();
+
+		InstructionSet instruction_set() const {
+			return selected;
+		}
+
+		// selects the kernels of an instruction set, which is limited to the supported ones (e.g. to compare them)
+		void use(InstructionSet instruction_set);
+
+		// 2D simplex noise (see Generator::noise)
+		void noise(const float* x, const float* y, float* result, std::size_t count) const;
+
+		// 3D simplex noise (see Generator::noise)
+		void noise(const float* x, const float* y, const float* z, float* result, std::size_t count) const;
+
+		// 2D noise sum configured by options (see Generator::noise)
+		void noise(const float* x, const float* y, float* result, std::size_t count, const Options& options) const;
+
+		// 3D noise sum configured by options (see Generator::noise)
+		void noise(const float* x, const float* y, const float* z, float* result, std::size_t count, const Options& options) const;
+
+		// 2D fractal brownian motion (see Generator::fBm)
+		void fBm(const float* x, const float* y, float* result, std::size_t count, uint8_t octaves = 4, float lacunarity = 2.0f, float gain = 0.5f) const;
+
+		// 3D fractal brownian motion (see Generator::fBm)
+		void fBm(const float* x, const float* y, const float* z, float* result, std::size_t count, uint8_t octaves = 4, float lacunarity = 2.0f, float gain = 0.5f) const;
+
+		// 2D ridged multi-fractal noise (see Generator::ridgedMF)
+		void ridgedMF(const float* x, const float* y, float* result, std::size_t count, float ridgeOffset = 1.0f, uint8_t octaves = 4, float lacunarity = 2.0f, float gain = 0.5f) const;
+
+		// 3D ridged multi-fractal noise (see Generator::ridgedMF)
+		void ridgedMF(const float* x, const float* y, const float* z, float* result, std::size_t count, float ridgeOffset = 1.0f, uint8_t octaves = 4, float lacunarity = 2.0f, float gain = 0.5f) const;
+
+	};
+
+}
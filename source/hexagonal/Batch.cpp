@@ -0,0 +1,222 @@
+#include "Batch.h"
+
+#if !defined(HEXAGONAL_NO_SIMD)
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define HEXAGONAL_SSE2
+		#include <emmintrin.h>
+	#endif
+	#if defined(HEXAGONAL_SSE2) && defined(__AVX2__)
+		#define HEXAGONAL_AVX2
+		#include <immintrin.h>
+	#endif
+#endif
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		namespace batch {
+
+			static_assert(sizeof(float2) == 2 * sizeof(float), "cartesian coordinates have to be tightly packed");
+			static_assert(sizeof(float3) == 3 * sizeof(float), "positions have to be tightly packed");
+
+			#if defined(HEXAGONAL_SSE2)
+
+			// Calculates the cartesian coordinates of four cells (see Cell::to_offset and Cell::to_cartesian).
+			// The y-component is negated as integer, since negating a converted zero would yield -0.0 instead of 0.0.
+			static void cartesian_of_four(const Cell* cells, bool right_handed, __m128& x, __m128& y) {
+				__m128 first = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cells)));
+				__m128 second = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + 2)));
+				__m128i u = _mm_castps_si128(_mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+				__m128i v = _mm_castps_si128(_mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+				__m128 offset_x = _mm_add_ps(_mm_cvtepi32_ps(u), _mm_mul_ps(_mm_set1_ps(0.5f), _mm_cvtepi32_ps(v)));
+				__m128 offset_y = _mm_cvtepi32_ps(right_handed ? _mm_sub_epi32(_mm_setzero_si128(), v) : v);
+				x = _mm_mul_ps(_mm_set1_ps(f::Sqrt_3), offset_x);
+				y = _mm_mul_ps(_mm_set1_ps(1.5f), offset_y);
+			}
+
+			// Stores four positions (x, 0, z) interleaved into twelve consecutive floats.
+			static void store_four_positions(float* destination, __m128 x, __m128 z) {
+				__m128 zero = _mm_setzero_ps();
+				__m128 low = _mm_unpacklo_ps(x, z); // x0 z0 x1 z1
+				__m128 high = _mm_unpackhi_ps(x, z); // x2 z2 x3 z3
+				__m128 low_x = _mm_unpacklo_ps(x, zero); // x0 0 x1 0
+				__m128 high_x = _mm_unpackhi_ps(x, zero); // x2 0 x3 0
+				_mm_storeu_ps(destination, _mm_shuffle_ps(low_x, low, _MM_SHUFFLE(2, 1, 1, 0))); // x0 0 z0 x1
+				_mm_storeu_ps(destination + 4, _mm_shuffle_ps(_mm_unpackhi_ps(zero, low), high_x, _MM_SHUFFLE(1, 0, 3, 0))); // 0 z1 x2 0
+				_mm_storeu_ps(destination + 8, _mm_shuffle_ps(high, _mm_unpackhi_ps(zero, high), _MM_SHUFFLE(3, 0, 2, 1))); // z2 x3 0 z3
+			}
+
+			// Rounds half away from zero like std::round, the values have to be within the range of int32.
+			static __m128d round(__m128d value) {
+				__m128d sign_mask = _mm_set1_pd(-0.0);
+				__m128d truncated = _mm_cvtepi32_pd(_mm_cvttpd_epi32(value));
+				__m128d deviation = _mm_andnot_pd(sign_mask, _mm_sub_pd(value, truncated));
+				__m128d step = _mm_or_pd(_mm_and_pd(value, sign_mask), _mm_set1_pd(1.0));
+				return _mm_add_pd(truncated, _mm_and_pd(_mm_cmpge_pd(deviation, _mm_set1_pd(0.5)), step));
+			}
+
+			static __m128d select(__m128d mask, __m128d one, __m128d other) {
+				return _mm_or_pd(_mm_and_pd(mask, one), _mm_andnot_pd(mask, other));
+			}
+
+			// Calculates and stores two cells of the given cartesian coordinates (see Cell::of and Cell::round).
+			static void store_two_cells(Cell* cells, __m128d x, __m128d y, bool right_handed) {
+				__m128d sign_mask = _mm_set1_pd(-0.0);
+				__m128d zero = _mm_setzero_pd();
+				if (right_handed) y = _mm_xor_pd(y, sign_mask);
+				__m128d u = _mm_mul_pd(_mm_set1_pd(d::One_Third), _mm_sub_pd(_mm_mul_pd(_mm_set1_pd(d::Sqrt_3), x), y));
+				__m128d v = _mm_mul_pd(_mm_set1_pd(d::Two_Thirds), y);
+				__m128d w = _mm_sub_pd(_mm_sub_pd(zero, u), v);
+				__m128d ru = round(u);
+				__m128d rv = round(v);
+				__m128d rw = round(w);
+				__m128d du = _mm_andnot_pd(sign_mask, _mm_sub_pd(u, ru));
+				__m128d dv = _mm_andnot_pd(sign_mask, _mm_sub_pd(v, rv));
+				__m128d dw = _mm_andnot_pd(sign_mask, _mm_sub_pd(w, rw));
+				__m128d adjust_u = _mm_and_pd(_mm_cmpgt_pd(du, dv), _mm_cmpgt_pd(du, dw));
+				__m128d adjust_v = _mm_andnot_pd(adjust_u, _mm_cmpgt_pd(dv, dw));
+				__m128d au = select(adjust_u, _mm_sub_pd(_mm_sub_pd(zero, rv), rw), ru);
+				__m128d av = select(adjust_v, _mm_sub_pd(_mm_sub_pd(zero, ru), rw), rv);
+				__m128i result = _mm_unpacklo_epi32(_mm_cvttpd_epi32(au), _mm_cvttpd_epi32(av)); // u0 v0 u1 v1
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(cells), result);
+			}
+
+			#endif
+
+			#if defined(HEXAGONAL_AVX2)
+
+			// Calculates the cartesian coordinates of eight cells (see cartesian_of_four).
+			static void cartesian_of_eight(const Cell* cells, bool right_handed, __m256& x, __m256& y) {
+				__m256 first = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells)));
+				__m256 second = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(cells + 4)));
+				// shuffling operates per 128-bit lane, so the 64-bit halves have to be reordered afterwards
+				__m256i u = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0))), _MM_SHUFFLE(3, 1, 2, 0));
+				__m256i v = _mm256_permute4x64_epi64(_mm256_castps_si256(_mm256_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1))), _MM_SHUFFLE(3, 1, 2, 0));
+				__m256 offset_x = _mm256_add_ps(_mm256_cvtepi32_ps(u), _mm256_mul_ps(_mm256_set1_ps(0.5f), _mm256_cvtepi32_ps(v)));
+				__m256 offset_y = _mm256_cvtepi32_ps(right_handed ? _mm256_sub_epi32(_mm256_setzero_si256(), v) : v);
+				x = _mm256_mul_ps(_mm256_set1_ps(f::Sqrt_3), offset_x);
+				y = _mm256_mul_ps(_mm256_set1_ps(1.5f), offset_y);
+			}
+
+			#endif
+
+			void to_cartesian(const Cell* cells, float2* cartesian, std::size_t count, Handedness handedness) {
+				std::size_t index = 0;
+				#if defined(HEXAGONAL_SSE2)
+				bool right_handed = handedness == Handedness::Right;
+				float* destination = reinterpret_cast<float*>(cartesian);
+				#if defined(HEXAGONAL_AVX2)
+				for (; index + 8 <= count; index += 8) {
+					__m256 x, y;
+					cartesian_of_eight(cells + index, right_handed, x, y);
+					__m256 low = _mm256_unpacklo_ps(x, y); // x0 y0 x1 y1 | x4 y4 x5 y5
+					__m256 high = _mm256_unpackhi_ps(x, y); // x2 y2 x3 y3 | x6 y6 x7 y7
+					_mm256_storeu_ps(destination + 2 * index, _mm256_permute2f128_ps(low, high, 0x20));
+					_mm256_storeu_ps(destination + 2 * index + 8, _mm256_permute2f128_ps(low, high, 0x31));
+				}
+				#endif
+				for (; index + 4 <= count; index += 4) {
+					__m128 x, y;
+					cartesian_of_four(cells + index, right_handed, x, y);
+					_mm_storeu_ps(destination + 2 * index, _mm_unpacklo_ps(x, y));
+					_mm_storeu_ps(destination + 2 * index + 4, _mm_unpackhi_ps(x, y));
+				}
+				#endif
+				for (; index < count; index++) {
+					cartesian[index] = cells[index].to_cartesian(handedness);
+				}
+			}
+
+			void to_positions(const Cell* cells, float3* positions, std::size_t count, Handedness handedness) {
+				std::size_t index = 0;
+				#if defined(HEXAGONAL_SSE2)
+				bool right_handed = handedness == Handedness::Right;
+				float* destination = reinterpret_cast<float*>(positions);
+				#if defined(HEXAGONAL_AVX2)
+				for (; index + 8 <= count; index += 8) {
+					__m256 x, z;
+					cartesian_of_eight(cells + index, right_handed, x, z);
+					store_four_positions(destination + 3 * index, _mm256_castps256_ps128(x), _mm256_castps256_ps128(z));
+					store_four_positions(destination + 3 * index + 12, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(z, 1));
+				}
+				#endif
+				for (; index + 4 <= count; index += 4) {
+					__m128 x, z;
+					cartesian_of_four(cells + index, right_handed, x, z);
+					store_four_positions(destination + 3 * index, x, z);
+				}
+				#endif
+				for (; index < count; index++) {
+					positions[index] = cells[index].to_position(handedness);
+				}
+			}
+
+			void to_texinates(const Cell* cells, float2* texinates, std::size_t count, float2 size, Handedness handedness) {
+				std::size_t index = 0;
+				#if defined(HEXAGONAL_SSE2)
+				bool right_handed = handedness == Handedness::Right;
+				float* destination = reinterpret_cast<float*>(texinates);
+				// divided instead of multiplied by the reciprocal, to remain bit-identical to the conversion of single cells
+				#if defined(HEXAGONAL_AVX2)
+				for (; index + 8 <= count; index += 8) {
+					__m256 x, y;
+					cartesian_of_eight(cells + index, right_handed, x, y);
+					x = _mm256_add_ps(_mm256_set1_ps(0.5f), _mm256_div_ps(x, _mm256_set1_ps(size.x)));
+					y = _mm256_add_ps(_mm256_set1_ps(0.5f), _mm256_div_ps(y, _mm256_set1_ps(size.y)));
+					__m256 low = _mm256_unpacklo_ps(x, y);
+					__m256 high = _mm256_unpackhi_ps(x, y);
+					_mm256_storeu_ps(destination + 2 * index, _mm256_permute2f128_ps(low, high, 0x20));
+					_mm256_storeu_ps(destination + 2 * index + 8, _mm256_permute2f128_ps(low, high, 0x31));
+				}
+				#endif
+				for (; index + 4 <= count; index += 4) {
+					__m128 x, y;
+					cartesian_of_four(cells + index, right_handed, x, y);
+					x = _mm_add_ps(_mm_set1_ps(0.5f), _mm_div_ps(x, _mm_set1_ps(size.x)));
+					y = _mm_add_ps(_mm_set1_ps(0.5f), _mm_div_ps(y, _mm_set1_ps(size.y)));
+					_mm_storeu_ps(destination + 2 * index, _mm_unpacklo_ps(x, y));
+					_mm_storeu_ps(destination + 2 * index + 4, _mm_unpackhi_ps(x, y));
+				}
+				#endif
+				for (; index < count; index++) {
+					texinates[index] = 0.5f + cells[index].to_cartesian(handedness) / size;
+				}
+			}
+
+			void cells_of(const float2* cartesian, Cell* cells, std::size_t count, Handedness handedness) {
+				std::size_t index = 0;
+				#if defined(HEXAGONAL_SSE2)
+				bool right_handed = handedness == Handedness::Right;
+				const float* source = reinterpret_cast<const float*>(cartesian);
+				for (; index + 2 <= count; index += 2) {
+					__m128 values = _mm_loadu_ps(source + 2 * index); // x0 y0 x1 y1
+					__m128 ordered = _mm_shuffle_ps(values, values, _MM_SHUFFLE(3, 1, 2, 0)); // x0 x1 y0 y1
+					store_two_cells(cells + index, _mm_cvtps_pd(ordered), _mm_cvtps_pd(_mm_movehl_ps(ordered, ordered)), right_handed);
+				}
+				#endif
+				for (; index < count; index++) {
+					cells[index] = Cell::of(cartesian[index], handedness);
+				}
+			}
+
+			void cells_of(const float3* positions, Cell* cells, std::size_t count, Handedness handedness) {
+				std::size_t index = 0;
+				#if defined(HEXAGONAL_SSE2)
+				bool right_handed = handedness == Handedness::Right;
+				for (; index + 2 <= count; index += 2) {
+					const float3& first = positions[index];
+					const float3& second = positions[index + 1];
+					store_two_cells(cells + index, _mm_set_pd(second.x, first.x), _mm_set_pd(second.z, first.z), right_handed);
+				}
+				#endif
+				for (; index < count; index++) {
+					cells[index] = Cell::of(positions[index], handedness);
+				}
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+
+#include <hexagonal/Cell.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// Batch conversions of whole arrays of cells, which are vectorized using SSE2 or AVX2 if available (scalar otherwise).
+		// The results are bit-identical to the corresponding conversions of single cells (see Cell::to_cartesian, Cell::to_position and Cell::of).
+		// Define "HEXAGONAL_NO_SIMD" to enforce the scalar implementation.
+		namespace batch {
+
+			// Converts "count" cells to cartesian coordinates.
+			void to_cartesian(const Cell* cells, float2* cartesian, std::size_t count, Handedness handedness = Handedness::Right);
+
+			// Converts "count" cells to world positions in the y=0 plane.
+			void to_positions(const Cell* cells, float3* positions, std::size_t count, Handedness handedness = Handedness::Left);
+
+			// Converts "count" cells to the texture coordinates of a map whose cartesian size is "size" (see Map::texinates).
+			void to_texinates(const Cell* cells, float2* texinates, std::size_t count, float2 size, Handedness handedness = Handedness::Left);
+
+			// Calculates the cells of "count" cartesian coordinates.
+			void cells_of(const float2* cartesian, Cell* cells, std::size_t count, Handedness handedness = Handedness::Right);
+
+			// Calculates the cells of "count" world positions by projecting them to the y=0 plane.
+			void cells_of(const float3* positions, Cell* cells, std::size_t count, Handedness handedness = Handedness::Left);
+
+			// Converts all cells to cartesian coordinates.
+			inline Lot<float2> to_cartesian(const Lot<Cell>& cells, Handedness handedness = Handedness::Right) {
+				Lot<float2> cartesian(cells.size());
+				to_cartesian(cells.data(), cartesian.data(), cells.size(), handedness);
+				return cartesian;
+			}
+
+			// Converts all cells to world positions in the y=0 plane.
+			inline Lot<float3> to_positions(const Lot<Cell>& cells, Handedness handedness = Handedness::Left) {
+				Lot<float3> positions(cells.size());
+				to_positions(cells.data(), positions.data(), cells.size(), handedness);
+				return positions;
+			}
+
+			// Calculates the cells of all world positions by projecting them to the y=0 plane.
+			inline Lot<Cell> cells_of(const Lot<float3>& positions, Handedness handedness = Handedness::Left) {
+				Lot<Cell> cells(positions.size());
+				cells_of(positions.data(), cells.data(), positions.size(), handedness);
+				return cells;
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <type_traits>
+
+#include <hexagonal/Hexagonal.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		namespace details {
+
+			// coordinate deltas of all directions (NorthEast, East, SouthEast, SouthWest, West, NorthWest)
+			constexpr int32 direction_u[6] { +1, +1, 0, -1, -1, 0 };
+			constexpr int32 direction_v[6] { -1, 0, +1, +1, 0, -1 };
+
+			// coordinate deltas of all headings (Northward, NorthEastward, ..., NorthWestward)
+			constexpr int32 heading_u[12] { +1, +2, +2, +2, +1, 0, -1, -2, -2, -2, -1, 0 };
+			constexpr int32 heading_v[12] { -2, -2, -1, 0, +1, +2, +2, +2, +1, 0, -1, -2 };
+
+			constexpr int32 absolute(int32 value) { return value < 0 ? -value : value; }
+
+		}
+
+		// Compact hexagonal coordinates with the same homogeneous coordinate system as "Coordinates" (u + v + w = 0).
+		// Cells only store u and v, are trivially copyable and can therefore be stored, copied and processed in bulk.
+		struct Cell {
+
+			int32 u, v;
+
+			// Creates the cell of the origin.
+			constexpr Cell() : u(0), v(0) {}
+
+			// Creates a cell with constraint u + v + w = 0.
+			constexpr Cell(int32 u, int32 v) : u(u), v(v) {}
+
+			constexpr int32 w() const { return 0 - u - v; }
+
+			// Creates a cell by rounding from floating point values. The value with the biggest deviation from an integer will be adjusted to satisfy u + v + w = 0.
+			static Cell round(double u, double v) {
+				double w = 0 - u - v;
+				double ru = std::round(u);
+				double rv = std::round(v);
+				double rw = std::round(w);
+				double du = std::abs(u - ru);
+				double dv = std::abs(v - rv);
+				double dw = std::abs(w - rw);
+				if (du > dv and du > dw) ru = 0 - rv - rw;
+				else if (dv > dw) rv = 0 - ru - rw;
+				return Cell(static_cast<int32>(ru), static_cast<int32>(rv));
+			}
+
+			// Returns the cell shifted in the given direction by the given distance.
+			constexpr Cell shifted(Direction direction, int32 distance = 1) const {
+				return Cell(u + details::direction_u[static_cast<uint8>(direction)] * distance, v + details::direction_v[static_cast<uint8>(direction)] * distance);
+			}
+
+			// Returns the cell shifted in the given heading by the given distance.
+			constexpr Cell shifted(Heading heading, int32 distance = 1) const {
+				return Cell(u + details::heading_u[static_cast<uint8>(heading)] * distance, v + details::heading_v[static_cast<uint8>(heading)] * distance);
+			}
+
+			// Shifts this cell in the given direction by the given distance.
+			Cell& shift(Direction direction, int32 distance = 1) {
+				return *this = shifted(direction, distance);
+			}
+
+			// Shifts this cell in the given heading by the given distance.
+			Cell& shift(Heading heading, int32 distance = 1) {
+				return *this = shifted(heading, distance);
+			}
+
+			// Rotates this cell by 60 degree per iteration in the given direction.
+			Cell& rotate(int iterations = 1, Rotating rotating = Rotating::Clockwise) {
+				if (rotating != Rotating::Clockwise) iterations = -iterations;
+				switch (project(iterations, 0, 5)) {
+					case 1: return *this = Cell(-v, u + v);
+					case 2: return *this = Cell(w(), u);
+					case 3: return *this = Cell(-u, -v);
+					case 4: return *this = Cell(v, w());
+					case 5: return *this = Cell(u + v, -u);
+					default: return *this;
+				}
+			}
+
+			constexpr Cell neighbor(Direction direction) const {
+				return shifted(direction);
+			}
+
+			constexpr Cell operator+(const Cell& other) const { return Cell(u + other.u, v + other.v); }
+			constexpr Cell operator-(const Cell& other) const { return Cell(u - other.u, v - other.v); }
+			constexpr Cell operator-() const { return Cell(-u, -v); }
+			Cell& operator+=(const Cell& other) { u += other.u; v += other.v; return *this; }
+			Cell& operator-=(const Cell& other) { u -= other.u; v -= other.v; return *this; }
+
+			constexpr Cell operator+(Direction direction) const { return shifted(direction); }
+			constexpr Cell operator-(Direction direction) const { return shifted(direction, -1); }
+			Cell& operator+=(Direction direction) { return shift(direction); }
+			Cell& operator-=(Direction direction) { return shift(direction, -1); }
+
+			constexpr Cell operator+(Heading heading) const { return shifted(heading); }
+			constexpr Cell operator-(Heading heading) const { return shifted(heading, -1); }
+			Cell& operator+=(Heading heading) { return shift(heading); }
+			Cell& operator-=(Heading heading) { return shift(heading, -1); }
+
+			constexpr bool operator==(const Cell& other) const { return u == other.u and v == other.v; }
+			constexpr bool operator!=(const Cell& other) const { return u != other.u or v != other.v; }
+
+			// Calculates the hexagonal distance to the origin.
+			constexpr unsigned magnitude() const {
+				return static_cast<unsigned>(details::absolute(u) + details::absolute(v) + details::absolute(w())) / 2;
+			}
+
+			// Returns the cell's component for a given axis.
+			int32 component(Axis axis) const {
+				switch (axis) {
+					case Axis::U: return u;
+					case Axis::V: return v;
+					case Axis::W: return w();
+					default: throw_runtime_exception();
+				}
+			}
+
+			// Determines the axis of the cell's dominant component.
+			Axis dominant_axis() const {
+				int32 au = details::absolute(u);
+				int32 av = details::absolute(v);
+				int32 aw = details::absolute(w());
+				if (au >= av and au >= aw) return Axis::U;
+				if (av >= aw) return Axis::V;
+				return Axis::W;
+			}
+
+			// Determines the general heading from the origin to this cell.
+			Heading general_heading() const {
+				runtime_assert(magnitude() != 0, "The origin cell has no general heading.");
+				auto axis = dominant_axis();
+				return heading_of(axis, component(axis) >= 0);
+			}
+
+			// Determines the general direction from the origin to this cell.
+			Direction general_direction() const {
+				return static_cast<Direction>(static_cast<uint8>(general_heading()) / 2);
+			}
+
+			float3 to_floats() const { return float3(u, v, w()); }
+
+			// Convertes this cell to offset coordinates.
+			float2 to_offset(Handedness handedness = Handedness::Right) const {
+				auto y = handedness == Handedness::Right ? -v : v;
+				return float2(u + 0.5f * v, y);
+			}
+
+			// Convertes this cell to cartesian coordinates.
+			float2 to_cartesian(Handedness handedness = Handedness::Right) const {
+				auto offset = to_offset(handedness);
+				return float2(f::Sqrt_3 * offset.x, 1.5f * offset.y);
+			}
+
+			// Convertes this cell to a world position in the y=0 plane.
+			float3 to_position(Handedness handedness = Handedness::Left) const {
+				float2 cartesian = to_cartesian(handedness);
+				return float3(cartesian.x, 0.0f, cartesian.y);
+			}
+
+			// Calculates the cell of the given cartesian coordinates.
+			static Cell of(float x, float y, Handedness handedness = Handedness::Right) {
+				y = handedness == Handedness::Right ? -y : y;
+				return round(d::One_Third * (d::Sqrt_3 * x - y), d::Two_Thirds * y);
+			}
+
+			// Calculates the cell of the given cartesian coordinates.
+			static Cell of(float2 cartesian, Handedness handedness = Handedness::Right) {
+				return of(cartesian.x, cartesian.y, handedness);
+			}
+
+			// Calculates the cell of the given world position by projecting it to the y=0 plane.
+			static Cell of(float3 position, Handedness handedness = Handedness::Left) {
+				return of(position.x, position.z, handedness);
+			}
+
+			// Calculates cells in a line between "begin" and "end" (see Coordinates::line).
+			static Lot<Cell> line(const Cell& begin, const Cell& end, bool supercover = false, bool edgecover = true);
+
+			// Calculates cells in a ring pattern with "radius" around "center".
+			static Lot<Cell> ring(unsigned radius, const Cell& center = Cell());
+
+			// Calculates cells in a spiral pattern with "radius" around "center".
+			static Lot<Cell> spiral(unsigned radius, const Cell& center = Cell());
+
+			// Calculates cells in a rectangle pattern with "width" and "height" at "origin".
+			static Lot<Cell> rectangle(unsigned width, unsigned height, const Cell& origin = Cell(), bool centered = true);
+
+		};
+
+		static_assert(sizeof(Cell) == 2 * sizeof(int32), "cells have to be tightly packed");
+		static_assert(std::is_trivially_copyable<Cell>::value, "cells have to be trivially copyable");
+
+		// Calculates the hexagonal distance between two cells.
+		constexpr unsigned distance(const Cell& one, const Cell& two) {
+			return (one - two).magnitude();
+		}
+
+		inline std::ostream& append(std::ostream& output, const Cell& cell, unsigned spacing = 4) {
+			auto width = std::setw(spacing);
+			output << "(" << width << cell.u << ", " << width << cell.v << ", " << width << cell.w() << ")";
+			return output;
+		}
+
+		inline std::ostream& operator<<(std::ostream& output, const Cell& cell) {
+			return append(output, cell);
+		}
+
+	}
+
+}
+
+namespace std {
+
+	template<>
+	struct hash<tenjix::hexagonal::Cell> {
+		size_t operator()(const tenjix::hexagonal::Cell& cell) const noexcept {
+			return tenjix::hash_combined(cell.u, cell.v);
+		}
+	};
+
+}
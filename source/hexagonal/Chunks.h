@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include <hexagonal/Map.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// Divides a map into square chunks of "chunk_size" columns and rows, of which only a limited number is resident.
+		// Chunks are generated on demand and the least recently used chunks are evicted once the capacity is exceeded.
+		// Coordinates are reprojected into the map, so horizontal and vertical wrapping is preserved.
+		template <class Chunk>
+		class Chunks {
+
+			struct Entry {
+				Chunk chunk;
+				std::list<unsigned>::iterator usage;
+			};
+
+			const Map* map = nullptr;
+			unsigned chunk_size = 0;
+			unsigned columns = 0;
+			unsigned rows = 0;
+			unsigned capacity = 0;
+
+			// chunk ids ordered from most to least recently used
+			std::list<unsigned> usage;
+			std::unordered_map<unsigned, Entry> resident;
+
+			void evict_least_recently_used() {
+				unsigned chunk = usage.back();
+				auto entry = resident.find(chunk);
+				if (evict) evict(chunk, entry->second.chunk);
+				resident.erase(entry);
+				usage.pop_back();
+			}
+
+		public:
+
+			static const unsigned Default_Chunk_Size = 64;
+
+			// generates the chunk with the given id
+			std::function<Chunk(unsigned chunk)> generate;
+			// releases the chunk with the given id before it is evicted
+			std::function<void(unsigned chunk, Chunk& evicted)> evict;
+
+			Chunks() = default;
+
+			Chunks(const Map& map, unsigned capacity, unsigned chunk_size = Default_Chunk_Size) : map(&map), chunk_size(chunk_size), capacity(capacity) {
+				columns = (map.width() + chunk_size - 1) / chunk_size;
+				rows = (map.height() + chunk_size - 1) / chunk_size;
+			}
+
+			Chunks(const Chunks&) = delete;
+			Chunks(Chunks&&) = default;
+			Chunks& operator=(const Chunks&) = delete;
+			Chunks& operator=(Chunks&&) = default;
+
+			// number of resident chunks
+			unsigned size() const {
+				return static_cast<unsigned>(resident.size());
+			}
+
+			// number of chunks of the whole map
+			unsigned count() const {
+				return columns * rows;
+			}
+
+			// determines the id of the chunk containing "coordinates"
+			unsigned chunk_of(const Cell& coordinates) const {
+				Cell reprojected = map->reproject(coordinates);
+				return map->column(reprojected) / chunk_size + map->row(reprojected) / chunk_size * columns;
+			}
+
+			// determines the index of "coordinates" within their chunk
+			unsigned local_index(const Cell& coordinates) const {
+				Cell reprojected = map->reproject(coordinates);
+				unsigned column = map->column(reprojected);
+				unsigned row = map->row(reprojected);
+				unsigned width = extent(column / chunk_size + row / chunk_size * columns).x;
+				return column % chunk_size + row % chunk_size * width;
+			}
+
+			// number of columns and rows of the given chunk, which are smaller at the right and bottom border of the map
+			unsigned2 extent(unsigned chunk) const {
+				unsigned column = chunk % columns * chunk_size;
+				unsigned row = chunk / columns * chunk_size;
+				return { minimum(chunk_size, map->width() - column), minimum(chunk_size, map->height() - row) };
+			}
+
+			// coordinates of the cell with the given index within the chunk, which is the inverse of "local_index"
+			Cell cell(unsigned chunk, unsigned local_index) const {
+				unsigned width = extent(chunk).x;
+				return map->at(chunk % columns * chunk_size + local_index % width, chunk / columns * chunk_size + local_index / width);
+			}
+
+			// coordinates of all cells of the given chunk ordered by their local index
+			Lot<Cell> cells(unsigned chunk) const {
+				unsigned column = chunk % columns * chunk_size;
+				unsigned row = chunk / columns * chunk_size;
+				unsigned2 size = extent(chunk);
+				Lot<Cell> cells;
+				cells.reserve(size.x * size.y);
+				for (unsigned y = 0; y < size.y; y++) {
+					for (unsigned x = 0; x < size.x; x++) {
+						cells.push_back(map->at(column + x, row + y));
+					}
+				}
+				return cells;
+			}
+
+			// determines the ids of all chunks with cells within "radius" columns and rows around "center"
+			// columns wrap around the map, while rows are limited to the map
+			Lot<unsigned> chunks_around(const Cell& center, unsigned radius) const {
+				Cell reprojected = map->reproject(center);
+				int column = map->column(reprojected);
+				int row = map->row(reprojected);
+				int first_row = maximum(row - static_cast<int>(radius), 0) / static_cast<int>(chunk_size);
+				int last_row = minimum(row + static_cast<int>(radius), static_cast<int>(map->height()) - 1) / static_cast<int>(chunk_size);
+				// step from chunk to chunk, since the last chunk of a row may be narrower
+				Lot<unsigned> chunk_columns;
+				for (int offset = -static_cast<int>(radius); offset <= static_cast<int>(radius) and chunk_columns.size() < columns;) {
+					unsigned wrapped = Map::wrap(column + offset, map->width());
+					unsigned chunk_column = wrapped / chunk_size;
+					if (std::find(chunk_columns.begin(), chunk_columns.end(), chunk_column) == chunk_columns.end()) chunk_columns.push_back(chunk_column);
+					offset += static_cast<int>(minimum((chunk_column + 1) * chunk_size, map->width()) - wrapped);
+				}
+				Lot<unsigned> chunks;
+				for (int chunk_row = first_row; chunk_row <= last_row; chunk_row++) {
+					for (auto chunk_column : chunk_columns) {
+						chunks.push_back(chunk_column + chunk_row * columns);
+					}
+				}
+				return chunks;
+			}
+
+			bool is_resident(unsigned chunk) const {
+				return resident.count(chunk) != 0;
+			}
+
+			// finds a resident chunk and marks it as recently used
+			Chunk* find(unsigned chunk) {
+				auto entry = resident.find(chunk);
+				if (entry == resident.end()) return nullptr;
+				usage.splice(usage.begin(), usage, entry->second.usage);
+				return &entry->second.chunk;
+			}
+
+			// finds a resident chunk without marking it as used
+			const Chunk* peek(unsigned chunk) const {
+				auto entry = resident.find(chunk);
+				if (entry == resident.end()) return nullptr;
+				return &entry->second.chunk;
+			}
+
+			// finds or generates a chunk and marks it as recently used, which may evict the least recently used chunk
+			Chunk& acquire(unsigned chunk) {
+				Chunk* found = find(chunk);
+				if (found) return *found;
+				runtime_assert(static_cast<bool>(generate), "chunks require a generator");
+				while (not usage.empty() and resident.size() >= capacity) {
+					evict_least_recently_used();
+				}
+				usage.push_front(chunk);
+				auto& entry = resident.emplace(chunk, Entry { generate(chunk), usage.begin() }).first->second;
+				return entry.chunk;
+			}
+
+			// acquires all given chunks, the capacity grows if it wouldn't suffice to keep them resident at once
+			void retain(const Lot<unsigned>& chunks) {
+				capacity = maximum(capacity, static_cast<unsigned>(chunks.size()));
+				for (auto chunk : chunks) {
+					acquire(chunk);
+				}
+			}
+
+			// evicts all resident chunks, which isn't done on destruction
+			void clear() {
+				while (not usage.empty()) {
+					evict_least_recently_used();
+				}
+			}
+
+			// calls "function" with the id and the chunk of all resident chunks
+			template <class Function>
+			void each(Function function) {
+				for (auto& entry : resident) {
+					function(entry.first, entry.second.chunk);
+				}
+			}
+
+		};
+
+	}
+
+}
@@ -1,5 +1,7 @@
 #include "Coordinates.h"
 
+#include <hexagonal/Ranges.h>
+
 namespace tenjix {
 
 	namespace hexagonal {
@@ -31,123 +33,68 @@ namespace tenjix {
 			{ 0, -2 } // NorthWestward (du=0)
 		};
 
-		Lot<Coordinates> Coordinates::line(const Coordinates& begin, const Coordinates& end, bool supercover, bool edgecover) {
-			Lot<Coordinates> line;
-			if (begin == end) return line;
-
-			// calculate length
-			auto vector = end - begin;
-			auto length = vector.magnitude();
-
-			trace("line from ", begin, " to ", end, " (length=", length, ", supercover=", supercover, ", edgecover", edgecover, ")");
-
-			auto general_direction = vector.general_direction();
-			int rotation = hexagonal::rotation(general_direction, Direction::East);
-			trace("general direction: ", general_direction, " (rotation=", rotation, ")");
-			Direction straight = general_direction;
-			Direction diagonal_up = hexagonal::rotate(straight, -1);
-			Direction diagonal_down = hexagonal::rotate(straight, 1);
-			Heading straight_up = hexagonal::rotate(vector.general_heading(), -2);
-			vector.rotate(rotation);
-
-			// calculate delta
-			auto delta = vector.to_offset();
-
-			// "2 * delta.x" and "delta.y" are always integers
-			int dx = static_cast<int>(2 * delta.x);
-			int dy = static_cast<int>(3 * delta.y);
-
-			// "y = m * x"  with  "m = delta.y/delta.x * sqrt(3)/2"  and  "x = sqrt(3)/2"
-			// "y = delta.y/delta.x * 3/4", so scale everything by "4*delta.x"="2*dx" to avoid division
-			// "s = unit hexagon side length = 1.0" is threshold
-
-			// run step-algorithm
-			Coordinates current = begin;
-			line.reserve(length + 1);
-			line.push_back(begin);
-			trace("begin ", begin);
-			int y = 0;
-			for (uint i = 1; i < length + 1; i++) {
-				y += dy; // y += m * x
-				int cover_y = y + dy; // y += m
-				if (y >= dx) { // y > s/2 ?
-					if (supercover) {
-						if (edgecover ? (y == dx or cover_y <= 2 * dx) : (cover_y < 2 * dx)) { // y == s/2 or y + m <= s ?
-							trace("cover straight");
-							line.push_back(current + straight);
-						} else if (edgecover ? (y >= 5 * dx) : (y > 5 * dx)) { // y >= 5 * s/2 ?
-							trace("cover straight_up");
-							line.push_back(current + straight_up);
-						}
-					}
-					trace("go diagonal up");
-					current += diagonal_up;
-					y -= 3 * dx; // y -= 3 * s/2
-				} else {
-					if (supercover) {
-						if (edgecover ? (abs(cover_y) >= 2 * dx) : (abs(cover_y) > 2 * dx)) { // |y + m| >= s ?
-							trace("cover ", (cover_y > 0 ? "diagonal_up" : "diagonal_down"));
-							line.push_back(current + (cover_y > 0 ? diagonal_up : diagonal_down));
-						} else if (edgecover ? (y <= -dx) : (y < -dx)) { // y <= -s/2 ?
-							trace("cover diagonal_down");
-							line.push_back(current + diagonal_down);
-						}
-					}
-					trace("go straight");
-					current += straight;
-					y += dy; // y += m
-				}
-				line.push_back(current);
-				trace("step ", i, " ", current);
+		// The following algorithms operate on "Coordinates" as well as on compact "Cell"s and collect the lazily calculated ranges.
+
+		template <class Range>
+		static auto collect(Range&& range) -> Lot<typename std::decay<decltype(*range.begin())>::type> {
+			Lot<typename std::decay<decltype(*range.begin())>::type> lot;
+			lot.reserve(range.size());
+			for (auto& coordinates : range) {
+				lot.push_back(coordinates);
 			}
-			runtime_assert(current == end, "invalid end coordinates of hexagonal line algorithm");
-			trace("end ", end);
+			return lot;
+		}
 
-			return line;
+		template <class Type>
+		static Lot<Type> line_of(const Type& begin, const Type& end, bool supercover, bool edgecover) {
+			return collect(line_range(begin, end, supercover, edgecover));
 		}
 
-		static void insert_ring(Lot<Coordinates>& Lot, unsigned radius, const Coordinates& center) {
-			Coordinates coordinates = center + Direction::West * radius;
-			for (unsigned direction = 0; direction < 6; direction++) {
-				for (unsigned r = 0; r < radius; r++) {
-					Lot.push_back(coordinates += static_cast<Direction>(direction) * 1);
-				}
-			}
+		template <class Type>
+		static Lot<Type> ring_of(unsigned radius, const Type& center) {
+			return collect(ring_range(radius, center));
+		}
+
+		template <class Type>
+		static Lot<Type> spiral_of(unsigned radius, const Type& center) {
+			return collect(spiral_range(radius, center));
+		}
+
+		template <class Type>
+		static Lot<Type> rectangle_of(unsigned width, unsigned height, const Type& origin, bool centered) {
+			return collect(rectangle_range(width, height, origin, centered));
+		}
+
+		Lot<Coordinates> Coordinates::line(const Coordinates& begin, const Coordinates& end, bool supercover, bool edgecover) {
+			return line_of(begin, end, supercover, edgecover);
 		}
 
 		Lot<Coordinates> Coordinates::ring(unsigned radius, const Coordinates& center) {
-			if (radius == 0) return { center };
-			Lot<Coordinates> ring;
-			ring.reserve(6 * radius);
-			insert_ring(ring, radius, center);
-			return ring;
+			return ring_of(radius, center);
 		}
 
 		Lot<Coordinates> Coordinates::spiral(unsigned radius, const Coordinates& center) {
-			if (radius == 0) return { center };
-			Lot<Coordinates> spiral { center };
-			spiral.reserve(1 + 3 * radius * (radius + 1)); // 1 + 6 * (1 + 2 + 3 + ...)
-			for (unsigned ring_radius = 1; ring_radius <= radius; ring_radius++) {
-				insert_ring(spiral, ring_radius, center);
-			}
-			return spiral;
+			return spiral_of(radius, center);
 		}
 
 		Lot<Coordinates> Coordinates::rectangle(unsigned width, unsigned height, const Coordinates& origin, bool centered) {
-			if (width == 0 and height == 0) return {};
-			Lot<Coordinates> rectangle;
-			rectangle.reserve(width * height);
-			int v_begin = centered ? -static_cast<int>(height / 2) : 0;
-			int v_end = centered ? v_begin + height : height;
-			int u_begin = centered ? -static_cast<int>(width / 2) : 0;
-			int u_end = centered ? u_begin + width : width;
-			for (int v = v_begin; v < v_end; v++) {
-				int offset = v / 2 - (v < 0 and is_odd(v));
-				for (int u = u_begin - offset; u < u_end - offset; u++) {
-					rectangle.push_back(origin + Coordinates(u, v));
-				}
-			}
-			return rectangle;
+			return rectangle_of(width, height, origin, centered);
+		}
+
+		Lot<Cell> Cell::line(const Cell& begin, const Cell& end, bool supercover, bool edgecover) {
+			return line_of(begin, end, supercover, edgecover);
+		}
+
+		Lot<Cell> Cell::ring(unsigned radius, const Cell& center) {
+			return ring_of(radius, center);
+		}
+
+		Lot<Cell> Cell::spiral(unsigned radius, const Cell& center) {
+			return spiral_of(radius, center);
+		}
+
+		Lot<Cell> Cell::rectangle(unsigned width, unsigned height, const Cell& origin, bool centered) {
+			return rectangle_of(width, height, origin, centered);
 		}
 
 		String Coordinates::to_string(unsigned spacing) const {
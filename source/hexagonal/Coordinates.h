@@ -3,6 +3,7 @@
 #include <iostream>
 #include <iomanip>
 
+#include <hexagonal/Cell.h>
 #include <hexagonal/Hexagonal.h>
 
 #include <utilities/Properties.h>
@@ -73,6 +74,9 @@ namespace tenjix {
 			// Creates coordinates of the origin.
 			Coordinates() : Coordinates(0, 0) {}
 
+			// Creates coordinates from a compact cell.
+			Coordinates(const Cell& cell) : Coordinates(cell.u, cell.v) {}
+
 			~Coordinates() {}
 
 			Coordinates(const Coordinates& other) : Coordinates(other._u, other._v) {}
@@ -87,6 +91,13 @@ namespace tenjix {
 				return Coordinates(_u, _v);
 			}
 
+			// Returns the compact cell of these coordinates.
+			Cell cell() const {
+				return Cell(_u, _v);
+			}
+
+			operator Cell() const { return cell(); }
+
 			// Shifts these coordinates in the given direction by the given distance.
 			Coordinates& shift(Direction direction, int distance = 1) {
 				switch (direction) {
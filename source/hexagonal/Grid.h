@@ -0,0 +1,89 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include <hexagonal/Chunks.h>
+#include <hexagonal/Map.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// Dense structure-of-arrays storage with one contiguous column per type, indexed by Map::index for a whole map
+		// or by Chunks::local_index for a single chunk.
+		template <class... Types>
+		class Grid {
+
+			std::tuple<Lot<Types>...> columns;
+			unsigned number_of_cells = 0;
+
+			template <std::size_t... Columns>
+			void resize(unsigned size, std::index_sequence<Columns...>) {
+				using expand = int[];
+				(void) expand { 0, (std::get<Columns>(columns).resize(size), 0)... };
+			}
+
+		public:
+
+			template <std::size_t Column>
+			using Type = typename std::tuple_element<Column, std::tuple<Types...>>::type;
+
+			explicit Grid(unsigned size = 0) {
+				resize(size);
+			}
+
+			explicit Grid(const Map& map) : Grid(map.width() * map.height()) {}
+
+			unsigned size() const {
+				return number_of_cells;
+			}
+
+			// resizes all columns to "size" cells, new cells are value-initialized
+			void resize(unsigned size) {
+				resize(size, std::index_sequence_for<Types...>());
+				number_of_cells = size;
+			}
+
+			// resizes all columns to the number of cells of "map"
+			void resize(const Map& map) {
+				resize(map.width() * map.height());
+			}
+
+			template <std::size_t Column>
+			Lot<Type<Column>>& column() {
+				return std::get<Column>(columns);
+			}
+
+			template <std::size_t Column>
+			const Lot<Type<Column>>& column() const {
+				return std::get<Column>(columns);
+			}
+
+			template <std::size_t Column>
+			Type<Column>& get(unsigned index) {
+				return std::get<Column>(columns)[index];
+			}
+
+			template <std::size_t Column>
+			const Type<Column>& get(unsigned index) const {
+				return std::get<Column>(columns)[index];
+			}
+
+			// accesses the attribute of the cell at "coordinates" in a grid storing the cells of one chunk of "chunks"
+			// the cells are indexed by their index within the chunk, since a whole-map index lies outside of all but the first chunk
+			template <std::size_t Column, class Chunk>
+			Type<Column>& at(const Chunks<Chunk>& chunks, const Cell& coordinates) {
+				return get<Column>(chunks.local_index(coordinates));
+			}
+
+			template <std::size_t Column, class Chunk>
+			const Type<Column>& at(const Chunks<Chunk>& chunks, const Cell& coordinates) const {
+				return get<Column>(chunks.local_index(coordinates));
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,753 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+#include <hexagonal/Pathfinding.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// Finds paths with HPA*, which searches abstract graphs of entrances before refining the path within single clusters.
+		// The map is divided into square clusters of "cluster_size" columns and rows, whose borders (including the horizontal wrap) are crossed at entrances.
+		// Clusters are grouped into square regions of "region_size" clusters, the entrances of the regions are the middle cluster entrances of each contiguous section of their borders.
+		// Queries search the graph of the regions and refine the path with the entrances of the clusters within the regions it crosses, so long distances only visit a few entrances per region.
+		// The costs between all entrances of a cluster or region are cached, edits only invalidate the affected clusters and regions which are rebuilt lazily on the next query.
+		// Paths are near-optimal, the deviation grows with the number of obstacles along the cluster and region borders.
+		template <class Costs = UniformCosts>
+		class HierarchicalPathfinder {
+
+			enum : unsigned { No_Slot = ~0u, No_Parent = ~0u, No_Target = ~0u };
+
+			// weight of the heuristic of the region search, which only selects the regions searched by the refinement
+			static constexpr float Region_Weight = 1.5f;
+
+			struct Exit {
+				// map index of the entrance on the other side of the border and its node, which is updated whenever the other side is rebuilt
+				unsigned target;
+				unsigned node;
+				float cost;
+			};
+
+			// entrances of a cluster or region
+			struct Entrances {
+				// map indices and cells of the entrances
+				Lot<unsigned> nodes;
+				Lot<Cell> cells;
+				// transitions of each entrance into neighboring clusters or regions
+				Lot<Lot<Exit>> exits;
+				// costs between all pairs of entrances, "costs[from * nodes.size() + to]"
+				Lot<float> costs;
+				bool dirty = true;
+			};
+
+			struct Node {
+				float priority;
+				unsigned index;
+				bool operator>(const Node& other) const { return priority > other.priority; }
+			};
+
+			// state of a search over the nodes of a level, which are numbered "cluster << bits | slot" (or region) followed by the virtual goal node
+			// the state of each node is kept together, since the nodes of a level are visited in no particular order
+			struct Search {
+				struct State {
+					float cost;
+					unsigned parent;
+					unsigned reached;
+					unsigned settled;
+				};
+				Lot<State> states;
+				Lot<Node> open;
+				unsigned stamp = 0;
+				unsigned goal = 0;
+				unsigned bits = 0;
+
+				void resize(unsigned groups, unsigned bits) {
+					this->bits = bits;
+					goal = groups << bits;
+					states.assign(goal + 1, State{ 0.0f, No_Parent, 0, 0 });
+					stamp = 0;
+				}
+
+				void begin() {
+					if (++stamp == 0) {
+						for (auto& state : states) {
+							state.reached = state.settled = 0;
+						}
+						stamp = 1;
+					}
+					open.clear();
+				}
+
+				void push(unsigned node, float cost, unsigned parent, float priority) {
+					State& state = states[node];
+					if (state.reached == stamp and not (cost < state.cost)) return;
+					state.reached = stamp;
+					state.cost = cost;
+					state.parent = parent;
+					open.push_back({ priority, node });
+					std::push_heap(open.begin(), open.end(), std::greater<Node>());
+				}
+
+				Node pop() {
+					std::pop_heap(open.begin(), open.end(), std::greater<Node>());
+					Node node = open.back();
+					open.pop_back();
+					return node;
+				}
+
+				// whether "cost" is lower than the cost of reaching the node so far
+				bool improves(unsigned node, float cost) const {
+					return states[node].reached != stamp or cost < states[node].cost;
+				}
+
+				bool is_settled(unsigned node) const {
+					return states[node].settled == stamp;
+				}
+
+				// marks the node as settled and returns its final cost
+				float settle(unsigned node) {
+					states[node].settled = stamp;
+					return states[node].cost;
+				}
+
+				float cost(unsigned node) const {
+					return is_settled(node) ? states[node].cost : Infinite_Cost;
+				}
+
+				unsigned group(unsigned node) const {
+					return node >> bits;
+				}
+
+				unsigned slot(unsigned node) const {
+					return node & ((1u << bits) - 1);
+				}
+			};
+
+			const Map* map;
+			Costs step_costs;
+			float minimum_cost;
+			unsigned width;
+			unsigned cluster_size;
+			unsigned columns;
+			unsigned rows;
+			unsigned region_size;
+			unsigned region_columns;
+			unsigned region_rows;
+
+			Lot<Entrances> clusters;
+			Lot<Entrances> regions;
+			// slot of each entrance cell within the nodes of its cluster
+			Lot<unsigned> slots;
+			// region of each cluster
+			Lot<unsigned> cluster_regions;
+			// regions whose clusters are searched are marked with "corridor_mark"
+			Lot<unsigned> corridor;
+			unsigned corridor_mark = 0;
+			bool dirty = true;
+
+			// searches within single clusters
+			Pathfinder local;
+			Lot<Cell> sources;
+			Lot<Cell> route;
+			Lot<Cell> segment;
+			Lot<std::pair<unsigned, unsigned>> section;
+			Lot<std::pair<unsigned, unsigned>> candidates;
+
+			// searches of the entrances of the clusters and of the regions
+			Search cluster_search;
+			Search region_search;
+			// costs from the start to the entrances of its cluster and region and from those of the goal's cluster and region to the goal
+			Lot<float> start_costs;
+			Lot<float> goal_costs;
+			Lot<float> start_region_costs;
+			Lot<float> goal_region_costs;
+			unsigned goal_cluster;
+			Lot<unsigned> chain;
+			Lot<unsigned> nodes;
+
+			Cell cell(unsigned index) const {
+				return map->at(index % width, index / width);
+			}
+
+			unsigned cluster_of(unsigned index) const {
+				return index % width / cluster_size + index / width / cluster_size * columns;
+			}
+
+			unsigned region_of(unsigned index) const {
+				return cluster_regions[cluster_of(index)];
+			}
+
+			// node of an entrance of a cluster within the cluster search
+			unsigned cluster_node(unsigned index) const {
+				return cluster_of(index) << cluster_search.bits | slots[index];
+			}
+
+			// node of an entrance of a region within the region search
+			unsigned region_node(unsigned index) const {
+				unsigned region = region_of(index);
+				auto& nodes = regions[region].nodes;
+				return region << region_search.bits | static_cast<unsigned>(std::find(nodes.begin(), nodes.end(), index) - nodes.begin());
+			}
+
+			const Cell& node_cell(const Search& search, const Lot<Entrances>& groups, unsigned node) const {
+				return groups[search.group(node)].cells[search.slot(node)];
+			}
+
+			// step costs limited to a single cluster, optionally reversed to search from the goal
+			auto within(unsigned cluster, bool reversed = false) const {
+				int first_column = static_cast<int>(cluster % columns * cluster_size);
+				int first_row = static_cast<int>(cluster / columns * cluster_size);
+				return [this, first_column, first_row, reversed](const Cell& from, const Cell& to) {
+					// cells left of or above the cluster wrap around to large offsets
+					unsigned column = static_cast<unsigned>(map->column(to) - first_column);
+					unsigned row = static_cast<unsigned>(map->row(to) - first_row);
+					if (column >= cluster_size or row >= cluster_size) return Infinite_Cost;
+					return reversed ? step_costs(to, from) : step_costs(from, to);
+				};
+			}
+
+			// estimated costs to "target", which are admissible since "minimum_cost" is a lower bound of all step costs
+			auto heuristic(const Search& search, const Lot<Entrances>& groups, const Cell& target) const {
+				return [this, &search, &groups, target](unsigned node) {
+					return node == search.goal ? 0.0f : lower_bound(node_cell(search, groups, node), target);
+				};
+			}
+
+			// lower bound of the costs between two cells within the map, which saves reprojecting them like "Pathfinder::distance"
+			float lower_bound(const Cell& one, const Cell& two) const {
+				Cell offset = one - two;
+				Cell wrap(static_cast<int>(width), 0);
+				return minimum_cost * std::min({ offset.magnitude(), (offset + wrap).magnitude(), (offset - wrap).magnitude() });
+			}
+
+			static float no_heuristic(unsigned node) {
+				return 0.0f;
+			}
+
+			unsigned add_node(Entrances& entrances, unsigned index, unsigned slot) {
+				if (slot == No_Slot) {
+					slot = static_cast<unsigned>(entrances.nodes.size());
+					entrances.nodes.push_back(index);
+					entrances.cells.push_back(cell(index));
+					entrances.exits.emplace_back();
+				}
+				return slot;
+			}
+
+			void add_exit(Lot<Exit>& exits, unsigned to, unsigned node, float cost) {
+				for (auto& exit : exits) {
+					if (exit.target == to) {
+						exit.node = node;
+						return;
+					}
+				}
+				exits.push_back({ to, node, cost });
+			}
+
+			// calls "function" with each contiguous section of transitions from the columns and rows of a cluster or region into the cells accepted by "outside"
+			// the border is always scanned from the cluster or region with the lower id, so rebuilding either side yields the same sections
+			template <class Outside, class Function>
+			void each_section(unsigned first_column, unsigned first_row, unsigned last_column, unsigned last_row, Outside outside, Function function) {
+				section.clear();
+				for (unsigned row = first_row; row <= last_row; row++) {
+					bool edge = row == first_row or row == last_row;
+					for (unsigned column = first_column; column <= last_column; column += edge or last_column == first_column ? 1 : last_column - first_column) {
+						Cell inside = map->at(column, row);
+						for (uint8 direction = 0; direction < 6; direction++) {
+							auto neighbor = map->neighbor(inside, static_cast<Direction>(direction));
+							if (not neighbor) continue;
+							unsigned index = map->index_unchecked(*neighbor);
+							if (not outside(index)) continue;
+							bool passable = step_costs(inside, *neighbor) < Infinite_Cost and step_costs(*neighbor, inside) < Infinite_Cost;
+							// a section ends at impassable transitions or if its cells aren't adjacent on both sides
+							// each border cell has up to three neighbors across the border, so the outer cell is compared to the last three transitions
+							if (not section.empty()) {
+								bool contiguous = false;
+								if (local.distance(cell(section.back().first), inside) <= 1) {
+									for (std::size_t previous = section.size(); previous > 0 and previous + 3 > section.size(); previous--) {
+										if (local.distance(cell(section[previous - 1].second), *neighbor) <= 1) contiguous = true;
+									}
+								}
+								if (not passable or not contiguous) {
+									function(section);
+									section.clear();
+								}
+							}
+							if (passable) section.emplace_back(column + row * width, index);
+						}
+					}
+				}
+				if (not section.empty()) function(section);
+			}
+
+			// adds an entrance for each contiguous section of the border between two clusters
+			void connect_clusters(unsigned one, unsigned other) {
+				unsigned from = minimum(one, other);
+				unsigned to = maximum(one, other);
+				unsigned first_column = from % columns * cluster_size;
+				unsigned first_row = from / columns * cluster_size;
+				unsigned last_column = minimum(first_column + cluster_size, width) - 1;
+				unsigned last_row = minimum(first_row + cluster_size, map->height()) - 1;
+				each_section(first_column, first_row, last_column, last_row, [&](unsigned index) { return cluster_of(index) == to; }, [&](const Lot<std::pair<unsigned, unsigned>>& section) {
+					auto transition = section[section.size() / 2];
+					slots[transition.first] = add_node(clusters[from], transition.first, slots[transition.first]);
+					slots[transition.second] = add_node(clusters[to], transition.second, slots[transition.second]);
+					Cell inside = cell(transition.first);
+					Cell outside = cell(transition.second);
+					add_exit(clusters[from].exits[slots[transition.first]], transition.second, cluster_node(transition.second), step_costs(inside, outside));
+					add_exit(clusters[to].exits[slots[transition.second]], transition.first, cluster_node(transition.first), step_costs(outside, inside));
+				});
+			}
+
+			// adds an entrance for each contiguous section of the border between two regions, which is the middle cluster entrance within the section
+			void connect_regions(unsigned one, unsigned other) {
+				unsigned from = minimum(one, other);
+				unsigned to = maximum(one, other);
+				unsigned size = region_size * cluster_size;
+				unsigned first_column = from % region_columns * size;
+				unsigned first_row = from / region_columns * size;
+				unsigned last_column = minimum(first_column + size, width) - 1;
+				unsigned last_row = minimum(first_row + size, map->height()) - 1;
+				each_section(first_column, first_row, last_column, last_row, [&](unsigned index) { return region_of(index) == to; }, [&](const Lot<std::pair<unsigned, unsigned>>& section) {
+					// every section contains the entrances of the cluster borders it spans
+					candidates.clear();
+					for (auto& transition : section) {
+						if (cluster_exit(transition.first, transition.second)) candidates.push_back(transition);
+					}
+					if (candidates.empty()) return;
+					auto transition = candidates[candidates.size() / 2];
+					auto& inside = regions[from];
+					auto& outside = regions[to];
+					unsigned inside_slot = add_node(inside, transition.first, slot_in(inside, transition.first));
+					unsigned outside_slot = add_node(outside, transition.second, slot_in(outside, transition.second));
+					add_exit(inside.exits[inside_slot], transition.second, to << region_search.bits | outside_slot, cluster_exit(transition.first, transition.second)->cost);
+					add_exit(outside.exits[outside_slot], transition.first, from << region_search.bits | inside_slot, cluster_exit(transition.second, transition.first)->cost);
+				});
+			}
+
+			static unsigned slot_in(const Entrances& entrances, unsigned index) {
+				auto slot = std::find(entrances.nodes.begin(), entrances.nodes.end(), index);
+				return slot == entrances.nodes.end() ? No_Slot : static_cast<unsigned>(slot - entrances.nodes.begin());
+			}
+
+			// transition between the entrances of two clusters, or null if there is none
+			const Exit* cluster_exit(unsigned from, unsigned to) const {
+				if (slots[from] == No_Slot) return nullptr;
+				for (auto& exit : clusters[cluster_of(from)].exits[slots[from]]) {
+					if (exit.target == to) return &exit;
+				}
+				return nullptr;
+			}
+
+			// calculates the costs between all entrances of a cluster
+			void calculate_cluster_costs(unsigned cluster) {
+				Entrances& entrances = clusters[cluster];
+				std::size_t count = entrances.nodes.size();
+				entrances.costs.assign(count * count, Infinite_Cost);
+				for (std::size_t from = 0; from < count; from++) {
+					sources.assign(1, entrances.cells[from]);
+					local.flood(sources, within(cluster));
+					for (std::size_t to = 0; to < count; to++) {
+						entrances.costs[from * count + to] = local.cost(entrances.cells[to]);
+					}
+				}
+			}
+
+			// calculates the costs between all entrances of a region by searching the entrances of its clusters
+			void calculate_region_costs(unsigned region) {
+				Entrances& entrances = regions[region];
+				std::size_t count = entrances.nodes.size();
+				entrances.costs.assign(count * count, Infinite_Cost);
+				for (std::size_t from = 0; from < count; from++) {
+					begin_corridor(region);
+					cluster_search.begin();
+					cluster_search.push(cluster_node(entrances.nodes[from]), 0.0f, No_Parent, 0.0f);
+					search_clusters(false, false, No_Target, no_heuristic);
+					for (std::size_t to = 0; to < count; to++) {
+						entrances.costs[from * count + to] = cluster_search.cost(cluster_node(entrances.nodes[to]));
+					}
+				}
+			}
+
+			// numbers the nodes of a search with enough bits for the largest cluster or region, which renumbers all exits if the bits have changed
+			void renumber(Search& search, Lot<Entrances>& groups, bool clustered) {
+				std::size_t largest = 1;
+				for (auto& entrances : groups) {
+					largest = maximum(largest, entrances.nodes.size());
+				}
+				unsigned bits = 0;
+				while ((std::size_t(1) << bits) < largest) bits++;
+				if (bits == search.bits and not search.states.empty()) return;
+				search.resize(static_cast<unsigned>(groups.size()), bits);
+				for (auto& entrances : groups) {
+					for (auto& exits : entrances.exits) {
+						for (auto& exit : exits) {
+							exit.node = clustered ? cluster_node(exit.target) : region_node(exit.target);
+						}
+					}
+				}
+			}
+
+			// removes all entrances of the given clusters or regions
+			void clear(Lot<Entrances>& groups, const Lot<unsigned>& affected, bool clustered) {
+				for (auto group : affected) {
+					Entrances& entrances = groups[group];
+					if (clustered) {
+						for (auto index : entrances.nodes) {
+							slots[index] = No_Slot;
+						}
+					}
+					entrances.nodes.clear();
+					entrances.cells.clear();
+					entrances.exits.clear();
+				}
+			}
+
+			// collects the dirty clusters or regions and their neighbors, which are no longer dirty afterwards
+			void collect_affected(Lot<Entrances>& groups, unsigned group_columns, unsigned group_rows, Lot<unsigned>& affected) {
+				affected.clear();
+				Lot<bool> is_affected(groups.size(), false);
+				for (unsigned group = 0; group < groups.size(); group++) {
+					if (not groups[group].dirty) continue;
+					groups[group].dirty = false;
+					each_neighbor(group, group_columns, group_rows, [&](unsigned neighbor) {
+						if (is_affected[neighbor]) return;
+						is_affected[neighbor] = true;
+						affected.push_back(neighbor);
+					});
+				}
+			}
+
+			// rebuilds all dirty clusters and regions, including the entrances of their neighbors
+			void rebuild() {
+				Lot<unsigned> affected;
+				collect_affected(clusters, columns, rows, affected);
+				clear(clusters, affected, true);
+				for (auto cluster : affected) {
+					each_neighbor(cluster, columns, rows, [&](unsigned neighbor) {
+						if (neighbor != cluster) connect_clusters(cluster, neighbor);
+					});
+				}
+				renumber(cluster_search, clusters, true);
+				for (auto cluster : affected) {
+					calculate_cluster_costs(cluster);
+					regions[cluster_regions[cluster]].dirty = true;
+				}
+
+				collect_affected(regions, region_columns, region_rows, affected);
+				clear(regions, affected, false);
+				for (auto region : affected) {
+					each_neighbor(region, region_columns, region_rows, [&](unsigned neighbor) {
+						if (neighbor != region) connect_regions(region, neighbor);
+					});
+				}
+				renumber(region_search, regions, false);
+				for (auto region : affected) {
+					calculate_region_costs(region);
+				}
+				dirty = false;
+			}
+
+			// calls "function" with the cluster or region itself and all surrounding ones, columns wrap around the map
+			template <class Function>
+			void each_neighbor(unsigned group, unsigned group_columns, unsigned group_rows, Function function) const {
+				int column = group % group_columns;
+				int row = group / group_columns;
+				unsigned visited[9];
+				unsigned count = 0;
+				for (int v = maximum(row - 1, 0); v <= minimum(row + 1, static_cast<int>(group_rows) - 1); v++) {
+					for (int u = column - 1; u <= column + 1; u++) {
+						unsigned neighbor = Map::wrap(u, group_columns) + v * group_columns;
+						if (std::find(visited, visited + count, neighbor) != visited + count) continue;
+						visited[count++] = neighbor;
+						function(neighbor);
+					}
+				}
+			}
+
+			// limits the searches of cluster entrances to "region", further regions can be added with "widen_corridor"
+			void begin_corridor(unsigned region) {
+				if (++corridor_mark == 0) {
+					std::fill(corridor.begin(), corridor.end(), 0);
+					corridor_mark = 1;
+				}
+				widen_corridor(region);
+			}
+
+			void widen_corridor(unsigned region) {
+				corridor[region] = corridor_mark;
+			}
+
+			// searches the entrances of the clusters within the corridor from the nodes pushed before, until "target" has been settled
+			// reversed searches follow the edges backwards to calculate the costs towards the nodes pushed before
+			// the virtual goal node is reached through the entrances of the goal's cluster if "to_goal" is set
+			template <class Heuristic>
+			void search_clusters(bool reversed, bool to_goal, unsigned target, Heuristic heuristic) {
+				Search& search = cluster_search;
+				while (not search.open.empty()) {
+					Node node = search.pop();
+					if (search.is_settled(node.index)) continue;
+					float cost = search.settle(node.index);
+					if (node.index == target or node.index == search.goal) {
+						if (node.index == target) return;
+						continue;
+					}
+					unsigned cluster = search.group(node.index);
+					unsigned slot = search.slot(node.index);
+					Entrances& entrances = clusters[cluster];
+					if (to_goal and cluster == goal_cluster and goal_costs[slot] < Infinite_Cost) {
+						search.push(search.goal, cost + goal_costs[slot], node.index, cost + goal_costs[slot]);
+					}
+					std::size_t count = entrances.nodes.size();
+					unsigned first = cluster << search.bits;
+					for (std::size_t other = 0; other < count; other++) {
+						float intra_cost = reversed ? entrances.costs[other * count + slot] : entrances.costs[slot * count + other];
+						unsigned next = first | static_cast<unsigned>(other);
+						if (other == slot or not (intra_cost < Infinite_Cost) or not search.improves(next, cost + intra_cost) or search.is_settled(next)) continue;
+						search.push(next, cost + intra_cost, node.index, cost + intra_cost + heuristic(next));
+					}
+					for (auto& exit : entrances.exits[slot]) {
+						if (corridor[cluster_regions[search.group(exit.node)]] != corridor_mark or search.is_settled(exit.node)) continue;
+						float exit_cost = reversed ? cluster_exit(exit.target, entrances.nodes[slot])->cost : exit.cost;
+						if (not search.improves(exit.node, cost + exit_cost)) continue;
+						search.push(exit.node, cost + exit_cost, node.index, cost + exit_cost + heuristic(exit.node));
+					}
+				}
+			}
+
+			// appends the nodes of the path to "node" found by the last search, excluding the virtual goal node
+			void append_path(const Search& search, unsigned node, Lot<unsigned>& path) {
+				std::size_t begin = path.size();
+				if (node == search.goal) node = search.states[node].parent;
+				for (; node != No_Parent; node = search.states[node].parent) {
+					path.push_back(node);
+				}
+				std::reverse(path.begin() + begin, path.end());
+			}
+
+			// pushes the entrances of the start's cluster and the goal if it can be reached directly
+			template <class Heuristic>
+			void push_start(unsigned start_cluster, float direct_cost, Heuristic heuristic) {
+				unsigned first = start_cluster << cluster_search.bits;
+				for (std::size_t slot = 0; slot < start_costs.size(); slot++) {
+					unsigned node = first | static_cast<unsigned>(slot);
+					if (start_costs[slot] < Infinite_Cost) cluster_search.push(node, start_costs[slot], No_Parent, start_costs[slot] + heuristic(node));
+				}
+				if (direct_cost < Infinite_Cost) cluster_search.push(cluster_search.goal, direct_cost, No_Parent, direct_cost);
+			}
+
+			// costs from "origin" to all entrances of its cluster, or from all entrances to "origin" if reversed
+			void entrance_costs(const Cell& origin, unsigned cluster, bool reversed, Lot<float>& result) {
+				sources.assign(1, origin);
+				local.flood(sources, within(cluster, reversed));
+				auto& cells = clusters[cluster].cells;
+				result.resize(cells.size());
+				for (std::size_t slot = 0; slot < cells.size(); slot++) {
+					result[slot] = local.cost(cells[slot]);
+				}
+			}
+
+		public:
+
+			static const unsigned Default_Cluster_Size = 16;
+			static const unsigned Default_Region_Size = 4;
+
+			// "minimum_cost" has to be a lower bound of all step costs to keep the heuristic admissible, "region_size" is the number of clusters per column and row of a region
+			explicit HierarchicalPathfinder(const Map& map, Costs step_costs = Costs(), float minimum_cost = 1.0f, unsigned cluster_size = Default_Cluster_Size, unsigned region_size = Default_Region_Size)
+				: map(&map), step_costs(step_costs), minimum_cost(minimum_cost), width(map.width()), cluster_size(cluster_size), region_size(region_size), local(map) {
+				columns = (map.width() + cluster_size - 1) / cluster_size;
+				rows = (map.height() + cluster_size - 1) / cluster_size;
+				region_columns = (columns + region_size - 1) / region_size;
+				region_rows = (rows + region_size - 1) / region_size;
+				clusters.resize(columns * rows);
+				regions.resize(region_columns * region_rows);
+				cluster_regions.resize(clusters.size());
+				corridor.resize(regions.size(), 0);
+				for (unsigned cluster = 0; cluster < clusters.size(); cluster++) {
+					cluster_regions[cluster] = cluster % columns / region_size + cluster / columns / region_size * region_columns;
+				}
+				slots.resize(map.width() * map.height(), No_Slot);
+			}
+
+			// cells have to be invalidated after their step costs have been changed
+			Costs& movement_costs() {
+				return step_costs;
+			}
+
+			// marks the cluster containing "coordinates" to be rebuilt, since the costs of entering or leaving the cell have changed
+			void invalidate(const Cell& coordinates) {
+				clusters[cluster_of(map->index(coordinates))].dirty = true;
+				dirty = true;
+			}
+
+			// marks all clusters to be rebuilt
+			void invalidate() {
+				for (auto& cluster : clusters) {
+					cluster.dirty = true;
+				}
+				dirty = true;
+			}
+
+			// number of entrances of all clusters, which are the nodes of the abstract graph within regions
+			unsigned entrances() {
+				if (dirty) rebuild();
+				unsigned count = 0;
+				for (auto& cluster : clusters) {
+					count += static_cast<unsigned>(cluster.nodes.size());
+				}
+				return count;
+			}
+
+			// number of entrances of all regions, which are the nodes of the abstract graph between regions
+			unsigned region_entrances() {
+				if (dirty) rebuild();
+				unsigned count = 0;
+				for (auto& region : regions) {
+					count += static_cast<unsigned>(region.nodes.size());
+				}
+				return count;
+			}
+
+			// finds the waypoints of an abstract path from "start" to "goal", which include both and are empty if the goal is unreachable
+			// consecutive waypoints are either within the same cluster or adjacent, the path between them is provided by "refine"
+			bool find_waypoints(const Cell& start, const Cell& goal, Lot<Cell>& waypoints) {
+				waypoints.clear();
+				if (dirty) rebuild();
+				Cell source = map->reproject(start);
+				Cell target = map->reproject(goal);
+				unsigned start_index = map->index(source);
+				unsigned goal_index = map->index(target);
+				unsigned start_cluster = cluster_of(start_index);
+				unsigned start_region = region_of(start_index);
+				unsigned goal_region = region_of(goal_index);
+				goal_cluster = cluster_of(goal_index);
+
+				// the start and goal are connected to the entrances of their clusters temporarily, paths within a single cluster may be cheaper than leaving it
+				entrance_costs(target, goal_cluster, true, goal_costs);
+				entrance_costs(source, start_cluster, false, start_costs);
+				float direct_cost = start_cluster == goal_cluster ? local.cost(target) : Infinite_Cost;
+
+				// costs from the start to the entrances of its region, which may already reach the goal
+				begin_corridor(start_region);
+				cluster_search.begin();
+				push_start(start_cluster, direct_cost, no_heuristic);
+				search_clusters(false, start_region == goal_region, No_Target, no_heuristic);
+				auto& start_entrances = regions[start_region].nodes;
+				start_region_costs.resize(start_entrances.size());
+				for (std::size_t slot = 0; slot < start_entrances.size(); slot++) {
+					start_region_costs[slot] = cluster_search.cost(cluster_node(start_entrances[slot]));
+				}
+				float region_cost = cluster_search.cost(cluster_search.goal);
+
+				// costs from the entrances of the goal's region to the goal
+				begin_corridor(goal_region);
+				cluster_search.begin();
+				for (std::size_t slot = 0; slot < goal_costs.size(); slot++) {
+					if (goal_costs[slot] < Infinite_Cost) cluster_search.push(goal_cluster << cluster_search.bits | static_cast<unsigned>(slot), goal_costs[slot], No_Parent, goal_costs[slot]);
+				}
+				search_clusters(true, false, No_Target, no_heuristic);
+				auto& goal_entrances = regions[goal_region].nodes;
+				goal_region_costs.resize(goal_entrances.size());
+				for (std::size_t slot = 0; slot < goal_entrances.size(); slot++) {
+					goal_region_costs[slot] = cluster_search.cost(cluster_node(goal_entrances[slot]));
+				}
+
+				// the regions are searched between the entrances of the start's and the goal's region, overestimating the costs to visit fewer regions
+				Search& search = region_search;
+				auto admissible = heuristic(search, regions, target);
+				auto estimate = [&admissible](unsigned node) {
+					return Region_Weight * admissible(node);
+				};
+				search.begin();
+				if (region_cost < Infinite_Cost) search.push(search.goal, region_cost, No_Parent, region_cost);
+				for (std::size_t slot = 0; slot < start_entrances.size(); slot++) {
+					unsigned node = start_region << search.bits | static_cast<unsigned>(slot);
+					if (start_region_costs[slot] < Infinite_Cost) search.push(node, start_region_costs[slot], No_Parent, start_region_costs[slot] + estimate(node));
+				}
+				while (not search.open.empty()) {
+					Node node = search.pop();
+					if (search.is_settled(node.index)) continue;
+					float cost = search.settle(node.index);
+					if (node.index == search.goal) break;
+					unsigned region = search.group(node.index);
+					unsigned slot = search.slot(node.index);
+					Entrances& entrances = regions[region];
+					if (region == goal_region and goal_region_costs[slot] < Infinite_Cost) {
+						search.push(search.goal, cost + goal_region_costs[slot], node.index, cost + goal_region_costs[slot]);
+					}
+					std::size_t count = entrances.nodes.size();
+					unsigned first = region << search.bits;
+					for (std::size_t other = 0; other < count; other++) {
+						float intra_cost = entrances.costs[slot * count + other];
+						unsigned next = first | static_cast<unsigned>(other);
+						if (other == slot or not (intra_cost < Infinite_Cost) or not search.improves(next, cost + intra_cost) or search.is_settled(next)) continue;
+						search.push(next, cost + intra_cost, node.index, cost + intra_cost + estimate(next));
+					}
+					for (auto& exit : entrances.exits[slot]) {
+						if (search.is_settled(exit.node) or not search.improves(exit.node, cost + exit.cost)) continue;
+						search.push(exit.node, cost + exit.cost, node.index, cost + exit.cost + estimate(exit.node));
+					}
+				}
+				if (not search.is_settled(search.goal)) return false;
+
+				// the path is refined with the entrances of the clusters within the regions it crosses, which are free to cross the region borders anywhere
+				chain.clear();
+				append_path(search, search.goal, chain);
+				begin_corridor(start_region);
+				for (auto node : chain) {
+					widen_corridor(search.group(node));
+				}
+				auto guide = heuristic(cluster_search, clusters, target);
+				cluster_search.begin();
+				push_start(start_cluster, direct_cost, guide);
+				search_clusters(false, true, cluster_search.goal, guide);
+				if (not cluster_search.is_settled(cluster_search.goal)) return false;
+				nodes.clear();
+				append_path(cluster_search, cluster_search.goal, nodes);
+
+				waypoints.push_back(source);
+				for (auto node : nodes) {
+					waypoints.push_back(node_cell(cluster_search, clusters, node));
+				}
+				waypoints.push_back(target);
+				// the start and goal may be entrances themselves
+				waypoints.erase(std::unique(waypoints.begin(), waypoints.end()), waypoints.end());
+				return true;
+			}
+
+			// finds the cheapest path between two consecutive waypoints, which includes both
+			bool refine(const Cell& from, const Cell& to, Lot<Cell>& path) {
+				unsigned from_index = map->index(from);
+				unsigned to_index = map->index(to);
+				unsigned cluster = cluster_of(from_index);
+				if (cluster != cluster_of(to_index)) {
+					path.clear();
+					path.push_back(map->reproject(from));
+					path.push_back(map->reproject(to));
+					return true;
+				}
+				return local.find_path(from, to, path, within(cluster), minimum_cost);
+			}
+
+			// finds a near-optimal path from "start" to "goal" by refining all waypoints, the path includes both and is empty if the goal is unreachable
+			bool find_path(const Cell& start, const Cell& goal, Lot<Cell>& path) {
+				path.clear();
+				if (not find_waypoints(start, goal, route)) return false;
+				path.push_back(route.front());
+				for (std::size_t waypoint = 1; waypoint < route.size(); waypoint++) {
+					if (not refine(route[waypoint - 1], route[waypoint], segment)) {
+						path.clear();
+						return false;
+					}
+					path.insert(path.end(), segment.begin() + 1, segment.end());
+				}
+				return true;
+			}
+
+		};
+
+	}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <hexagonal/Batch.h>
 #include <hexagonal/Coordinates.h>
 
 #include <utilities/Optional.h>
@@ -32,19 +33,52 @@ namespace tenjix {
 
 			ReadonlyProperty<unsigned, Map> width;
 			ReadonlyProperty<unsigned, Map> height;
-			ReadonlyProperty<Lot<Coordinates>, Map> coordinates;
+			ReadonlyProperty<Lot<Cell>, Map> coordinates;
 			ReadonlyProperty<unsigned2, Map> size;
 			ReadonlyProperty<float2, Map> cartesian_size;
 
-			// calculates the array index for given coordinates
-			unsigned index(const Coordinates& coordinates) const {
-				Coordinates reprojected = reproject(coordinates);
-				unsigned u = reprojected.u - (u_begin - u_offset(reprojected.v));
-				unsigned v = reprojected.v - v_begin;
-				return u + v * width;
+			// wraps "value" into [0, size) without branching
+			static unsigned wrap(int value, unsigned size) {
+				int remainder = value % static_cast<int>(size);
+				return static_cast<unsigned>(remainder + (static_cast<int>(size) & -static_cast<int>(remainder < 0)));
 			}
 
-			Map(unsigned width = 0, unsigned height = 0) : width(width), height(height), size({ width, height }), cartesian_size(float2(width, height) * Coordinates::Spacing) {
+			// column of "coordinates" within their row, which is unaffected by vertical wrapping
+			int column(const Cell& coordinates) const {
+				return coordinates.u + u_offset(coordinates.v) - u_begin;
+			}
+
+			// row of "coordinates", which is negative or exceeds the height if they lie outside of the map
+			int row(const Cell& coordinates) const {
+				return coordinates.v - v_begin;
+			}
+
+			// coordinates of the cell in "column" and "row" of the map
+			Cell at(unsigned column, unsigned row) const {
+				int v = v_begin + static_cast<int>(row);
+				return Cell(u_begin - u_offset(v) + static_cast<int>(column), v);
+			}
+
+			// calculates the array index for given coordinates, which are wrapped if they lie outside of the map
+			unsigned index(const Cell& coordinates) const {
+				unsigned u = column(coordinates);
+				unsigned v = row(coordinates);
+				if (u < width and v < height) return u + v * width;
+				return wrapped_index(coordinates);
+			}
+
+			// calculates the array index for given coordinates, which have to lie within the map
+			unsigned index_unchecked(const Cell& coordinates) const {
+				return column(coordinates) + row(coordinates) * width;
+			}
+
+			// calculates the array index for given coordinates by wrapping them horizontally and vertically without branching
+			unsigned wrapped_index(const Cell& coordinates) const {
+				return wrap(column(coordinates), width) + wrap(row(coordinates), height) * width;
+			}
+
+			// creates a map and enumerates the coordinates of all its cells unless "enumerate" is false (e.g. for chunked maps)
+			Map(unsigned width = 0, unsigned height = 0, bool enumerate = true) : width(width), height(height), size({ width, height }), cartesian_size(float2(width, height) * Coordinates::Spacing) {
 				this->width.owner = this;
 				this->height.owner = this;
 				coordinates.owner = this;
@@ -56,55 +90,53 @@ namespace tenjix {
 				v_begin = -static_cast<int>(height / 2);
 				v_end = v_begin + height - 1;
 
+				if (not enumerate) return;
 				coordinates->reserve(width * height);
 				for (int v = v_begin; v <= v_end; v++) {
 					int offset = u_offset(v);
 					for (int u = u_begin - offset; u <= u_end - offset; u++) {
-						coordinates->push_back(Coordinates(u, v));
+						coordinates->push_back(Cell(u, v));
 					}
 				}
 			}
 
 			// determines whether "coordinates" lie within the horizontal limits of the map
-			bool contains_horizontally(Coordinates coordinates) const {
+			bool contains_horizontally(Cell coordinates) const {
 				return contains_horizontally(coordinates.u, u_offset(coordinates.v));
 			}
 
 			// determines whether "coordinates" lie within the vertical limits of the map
-			bool contains_vertically(Coordinates coordinates) const {
+			bool contains_vertically(Cell coordinates) const {
 				return contains_vertically(coordinates.v);
 			}
 
 			// determines whether "coordinates" lie within the horizontal and vertical limits of the map
-			bool contains(Coordinates coordinates) const {
+			bool contains(Cell coordinates) const {
 				return contains_vertically(coordinates) and contains_horizontally(coordinates);
 			}
 
-			optional<Coordinates> neighbor(const Coordinates& coordinates, Direction direction) const {
-				Coordinates neighbor_coordinates = coordinates.neighbor(direction);
+			optional<Cell> neighbor(const Cell& coordinates, Direction direction) const {
+				Cell neighbor_coordinates = coordinates.neighbor(direction);
 				if (not contains_vertically(neighbor_coordinates)) return {};
 				return reproject(neighbor_coordinates);
 			}
 
 			// reprojects "coordinates" into the map by wrapping horizontally and vertically
-			Coordinates reproject(const Coordinates& coordinates) const {
-				int u = coordinates.u;
-				int v = coordinates.v;
-				int offset = u_offset(v);
-				if (not contains_horizontally(u, offset)) {
-					u = project(u, u_begin - offset, u_end - offset);
-				}
-				if (not contains_vertically(v)) {
-					v = project(v, v_begin, v_end);
-					u -= u_offset(v) - offset;
-				}
-				return Coordinates(u, v);
+			Cell reproject(const Cell& coordinates) const {
+				int v = v_begin + static_cast<int>(wrap(row(coordinates), height));
+				int u = u_begin - u_offset(v) + static_cast<int>(wrap(column(coordinates), width));
+				return Cell(u, v);
 			}
 
-			float2 texinates(const Coordinates& coordinates) const {
+			float2 texinates(const Cell& coordinates) const {
 				return 0.5f + coordinates.to_cartesian(Handedness::Left) / cartesian_size();
 			}
 
+			// calculates the texture coordinates of "count" coordinates at once
+			void texinates(const Cell* coordinates, float2* texinates, std::size_t count) const {
+				batch::to_texinates(coordinates, texinates, count, cartesian_size(), Handedness::Left);
+			}
+
 		};
 
 	}
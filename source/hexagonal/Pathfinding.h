@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+#include <hexagonal/Map.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// cost of impassable cells
+		constexpr float Infinite_Cost = std::numeric_limits<float>::infinity();
+
+		// Each step costs 1, which results in paths of minimal hexagonal distance.
+		struct UniformCosts {
+
+			float operator()(const Cell& from, const Cell& to) const {
+				return 1.0f;
+			}
+
+		};
+
+		// Movement costs derived from base costs per cell (e.g. by biome, infinite for impassable cells) and the slope between neighbors.
+		// Both arrays are indexed by Map::index, climbing costs "slope_factor" per unit of elevation gain.
+		struct TerrainCosts {
+
+			const Map* map;
+			const float* base_costs;
+			const float* elevations;
+			float slope_factor = 1.0f;
+
+			TerrainCosts(const Map& map, const float* base_costs, const float* elevations, float slope_factor = 1.0f) : map(&map), base_costs(base_costs), elevations(elevations), slope_factor(slope_factor) {}
+
+			float operator()(const Cell& from, const Cell& to) const {
+				unsigned to_index = map->index(to);
+				return base_costs[to_index] + slope_factor * maximum(elevations[to_index] - elevations[map->index(from)], 0.0f);
+			}
+
+		};
+
+		// Finds paths on a map with A* or multi-source Dijkstra, which wrap horizontally like Map::neighbor.
+		// Costs are provided by a callable "float(const Cell& from, const Cell& to)" returning the cost of entering "to" or infinity if it is impassable.
+		// All buffers are sized to the map once and reused, so repeated queries don't allocate (except for growing the resulting path).
+		class Pathfinder {
+
+			struct Node {
+				float priority;
+				unsigned index;
+				bool operator>(const Node& other) const { return priority > other.priority; }
+			};
+
+			const Map* map;
+			unsigned width;
+
+			// costs, parents and states are only valid if their stamp equals the current search
+			Lot<float> costs;
+			Lot<unsigned> parents;
+			Lot<unsigned> reached;
+			Lot<unsigned> settled;
+			Lot<Node> open;
+			unsigned search = 0;
+
+			void begin_search() {
+				if (++search == 0) {
+					std::fill(reached.begin(), reached.end(), 0);
+					std::fill(settled.begin(), settled.end(), 0);
+					search = 1;
+				}
+				open.clear();
+			}
+
+			void push(unsigned index, float cost, unsigned parent, float priority) {
+				reached[index] = search;
+				costs[index] = cost;
+				parents[index] = parent;
+				open.push_back({ priority, index });
+				std::push_heap(open.begin(), open.end(), std::greater<Node>());
+			}
+
+			Node pop() {
+				std::pop_heap(open.begin(), open.end(), std::greater<Node>());
+				Node node = open.back();
+				open.pop_back();
+				return node;
+			}
+
+			Cell cell(unsigned index) const {
+				return map->at(index % width, index / width);
+			}
+
+			// relaxes the edges to all neighbors of a settled node
+			template <class Costs, class Heuristic>
+			void expand(const Node& node, Costs& step_costs, Heuristic heuristic) {
+				Cell current = cell(node.index);
+				float cost = costs[node.index];
+				for (uint8 direction = 0; direction < 6; direction++) {
+					auto neighbor = map->neighbor(current, static_cast<Direction>(direction));
+					if (not neighbor) continue;
+					unsigned index = map->index_unchecked(*neighbor);
+					if (settled[index] == search) continue;
+					float step_cost = step_costs(current, *neighbor);
+					if (not (step_cost < Infinite_Cost)) continue;
+					float neighbor_cost = cost + step_cost;
+					if (reached[index] != search or neighbor_cost < costs[index]) {
+						push(index, neighbor_cost, node.index, neighbor_cost + heuristic(*neighbor));
+					}
+				}
+			}
+
+		public:
+
+			explicit Pathfinder(const Map& map) : map(&map), width(map.width()) {
+				unsigned size = map.width() * map.height();
+				costs.resize(size);
+				parents.resize(size);
+				reached.resize(size, 0);
+				settled.resize(size, 0);
+			}
+
+			// calculates the hexagonal distance between two cells, taking horizontal wrapping into account
+			unsigned distance(const Cell& one, const Cell& two) const {
+				Cell from = map->reproject(one);
+				Cell to = map->reproject(two);
+				// shifting by the map width along the u-axis keeps the row
+				Cell wrap(width, 0);
+				return minimum(hexagonal::distance(from, to), minimum(hexagonal::distance(from, to + wrap), hexagonal::distance(from, to - wrap)));
+			}
+
+			// finds the cheapest path from "start" to "goal" with A*, the path includes both and is empty if the goal is unreachable
+			// "minimum_cost" has to be a lower bound of all step costs to keep the heuristic admissible
+			template <class Costs = UniformCosts>
+			bool find_path(const Cell& start, const Cell& goal, Lot<Cell>& path, Costs step_costs = Costs(), float minimum_cost = 1.0f) {
+				path.clear();
+				begin_search();
+				Cell target = map->reproject(goal);
+				unsigned goal_index = map->index(target);
+				auto heuristic = [&](const Cell& cell) {
+					return minimum_cost * distance(cell, target);
+				};
+				unsigned start_index = map->index(start);
+				push(start_index, 0.0f, start_index, heuristic(map->reproject(start)));
+				while (not open.empty()) {
+					Node node = pop();
+					if (settled[node.index] == search) continue;
+					settled[node.index] = search;
+					if (node.index == goal_index) {
+						reconstruct(goal_index, path);
+						return true;
+					}
+					expand(node, step_costs, heuristic);
+				}
+				return false;
+			}
+
+			// finds the cheapest path from "start" to "goal" with A* (see find_path)
+			template <class Costs = UniformCosts>
+			Lot<Cell> path(const Cell& start, const Cell& goal, Costs step_costs = Costs(), float minimum_cost = 1.0f) {
+				Lot<Cell> path;
+				find_path(start, goal, path, step_costs, minimum_cost);
+				return path;
+			}
+
+			// calculates the costs from the nearest of all "sources" to every cell with Dijkstra, up to "maximum_cost"
+			// afterwards "cost" and "path_to" provide the results until the next query
+			template <class Costs = UniformCosts>
+			void flood(const Lot<Cell>& sources, Costs step_costs = Costs(), float maximum_cost = Infinite_Cost) {
+				begin_search();
+				auto no_heuristic = [](const Cell& cell) {
+					return 0.0f;
+				};
+				for (auto& source : sources) {
+					unsigned index = map->index(source);
+					push(index, 0.0f, index, 0.0f);
+				}
+				while (not open.empty()) {
+					Node node = pop();
+					if (settled[node.index] == search) continue;
+					if (node.priority > maximum_cost) break;
+					settled[node.index] = search;
+					expand(node, step_costs, no_heuristic);
+				}
+			}
+
+			// cost of the cheapest path to "coordinates" found by the last query, infinite if they haven't been reached
+			float cost(const Cell& coordinates) const {
+				unsigned index = map->index(coordinates);
+				return settled[index] == search ? costs[index] : Infinite_Cost;
+			}
+
+			// reconstructs the path from the nearest source of the last query to "coordinates", which is empty if they haven't been reached
+			bool path_to(const Cell& coordinates, Lot<Cell>& path) const {
+				path.clear();
+				unsigned index = map->index(coordinates);
+				if (settled[index] != search) return false;
+				reconstruct(index, path);
+				return true;
+			}
+
+		private:
+
+			void reconstruct(unsigned index, Lot<Cell>& path) const {
+				while (true) {
+					path.push_back(cell(index));
+					if (parents[index] == index) break;
+					index = parents[index];
+				}
+				std::reverse(path.begin(), path.end());
+			}
+
+		};
+
+	}
+
+}
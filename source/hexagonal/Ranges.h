@@ -0,0 +1,316 @@
+#pragma once
+
+#include <iterator>
+
+#include <hexagonal/Coordinates.h>
+#include <utilities/Logging.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// Single-pass range of coordinates which are calculated on demand by "Generator::advance()" without any allocation.
+		// A generator exposes the "current" coordinates and a "valid" flag and returns false from "advance()" when exhausted.
+		template <class Type, class Generator>
+		class Generated {
+
+		public:
+
+			class Iterator {
+
+				Generator* generator;
+
+			public:
+
+				using iterator_category = std::input_iterator_tag;
+				using value_type = Type;
+				using difference_type = std::ptrdiff_t;
+				using pointer = const Type*;
+				using reference = const Type&;
+
+				explicit Iterator(Generator* generator = nullptr) : generator(generator) {}
+
+				reference operator*() const { return generator->current; }
+				pointer operator->() const { return &generator->current; }
+
+				Iterator& operator++() {
+					if (not generator->advance()) generator = nullptr;
+					return *this;
+				}
+
+				bool operator==(const Iterator& other) const { return generator == other.generator; }
+				bool operator!=(const Iterator& other) const { return generator != other.generator; }
+
+			};
+
+			Iterator begin() {
+				auto generator = static_cast<Generator*>(this);
+				return Iterator(generator->valid ? generator : nullptr);
+			}
+
+			Iterator end() {
+				return Iterator();
+			}
+
+		};
+
+		// Lazily calculates hexagonal coordinates in a line between "begin" and "end" (see Coordinates::line).
+		template <class Type>
+		class LineRange : public Generated<Type, LineRange<Type>> {
+
+			friend class Generated<Type, LineRange<Type>>;
+
+			Type position, target;
+			Direction straight, diagonal_up, diagonal_down;
+			Heading straight_up;
+			bool supercover, edgecover;
+			bool pending = false;
+			unsigned step = 0;
+			unsigned length;
+			int dx, dy, y = 0;
+
+		public:
+
+			Type current;
+			bool valid;
+
+			LineRange(const Type& begin, const Type& end, bool supercover = false, bool edgecover = true) : position(begin), target(end), supercover(supercover), edgecover(edgecover), current(begin) {
+				valid = begin != end;
+				if (not valid) return;
+
+				// calculate length
+				auto vector = end - begin;
+				length = vector.magnitude();
+
+				TENJIX_TRACE("line from ", begin, " to ", end, " (length=", length, ", supercover=", supercover, ", edgecover", edgecover, ")");
+
+				auto general_direction = vector.general_direction();
+				int rotation = hexagonal::rotation(general_direction, Direction::East);
+				TENJIX_TRACE("general direction: ", general_direction, " (rotation=", rotation, ")");
+				straight = general_direction;
+				diagonal_up = hexagonal::rotate(straight, -1);
+				diagonal_down = hexagonal::rotate(straight, 1);
+				straight_up = hexagonal::rotate(vector.general_heading(), -2);
+				vector.rotate(rotation);
+
+				// calculate delta
+				auto delta = vector.to_offset();
+
+				// "2 * delta.x" and "delta.y" are always integers
+				dx = static_cast<int>(2 * delta.x);
+				dy = static_cast<int>(3 * delta.y);
+
+				// "y = m * x"  with  "m = delta.y/delta.x * sqrt(3)/2"  and  "x = sqrt(3)/2"
+				// "y = delta.y/delta.x * 3/4", so scale everything by "4*delta.x"="2*dx" to avoid division
+				// "s = unit hexagon side length = 1.0" is threshold
+
+				TENJIX_TRACE("begin ", begin);
+			}
+
+			// maximum number of coordinates without supercover
+			unsigned size() const {
+				return valid ? length + 1 : 0;
+			}
+
+		private:
+
+			// runs one iteration of the step-algorithm, a covered neighbor is yielded before the next step
+			bool advance() {
+				if (pending) {
+					pending = false;
+					current = position;
+					return true;
+				}
+				if (step == length) {
+					runtime_assert(position == target, "invalid end coordinates of hexagonal line algorithm");
+					TENJIX_TRACE("end ", target);
+					return false;
+				}
+				step++;
+				y += dy; // y += m * x
+				int cover_y = y + dy; // y += m
+				if (y >= dx) { // y > s/2 ?
+					if (supercover) {
+						if (edgecover ? (y == dx or cover_y <= 2 * dx) : (cover_y < 2 * dx)) { // y == s/2 or y + m <= s ?
+							TENJIX_TRACE("cover straight");
+							current = position + straight;
+							pending = true;
+						} else if (edgecover ? (y >= 5 * dx) : (y > 5 * dx)) { // y >= 5 * s/2 ?
+							TENJIX_TRACE("cover straight_up");
+							current = position + straight_up;
+							pending = true;
+						}
+					}
+					TENJIX_TRACE("go diagonal up");
+					position += diagonal_up;
+					y -= 3 * dx; // y -= 3 * s/2
+				} else {
+					if (supercover) {
+						if (edgecover ? (abs(cover_y) >= 2 * dx) : (abs(cover_y) > 2 * dx)) { // |y + m| >= s ?
+							TENJIX_TRACE("cover ", (cover_y > 0 ? "diagonal_up" : "diagonal_down"));
+							current = position + (cover_y > 0 ? diagonal_up : diagonal_down);
+							pending = true;
+						} else if (edgecover ? (y <= -dx) : (y < -dx)) { // y <= -s/2 ?
+							TENJIX_TRACE("cover diagonal_down");
+							current = position + diagonal_down;
+							pending = true;
+						}
+					}
+					TENJIX_TRACE("go straight");
+					position += straight;
+					y += dy; // y += m
+				}
+				TENJIX_TRACE("step ", step, " ", position);
+				if (not pending) current = position;
+				return true;
+			}
+
+		};
+
+		// Lazily calculates hexagonal coordinates in a ring pattern with "radius" around "center".
+		template <class Type>
+		class RingRange : public Generated<Type, RingRange<Type>> {
+
+			friend class Generated<Type, RingRange<Type>>;
+
+			unsigned radius;
+			unsigned index = 0;
+
+		public:
+
+			Type current;
+			bool valid = true;
+
+			RingRange(unsigned radius, const Type& center) : radius(radius), current(center) {
+				if (radius == 0) return;
+				current.shift(Direction::West, radius);
+				advance();
+			}
+
+			unsigned size() const {
+				return radius == 0 ? 1 : 6 * radius;
+			}
+
+		private:
+
+			bool advance() {
+				if (index == 6 * radius) return false;
+				current.shift(static_cast<Direction>(index++ / radius));
+				return true;
+			}
+
+		};
+
+		// Lazily calculates hexagonal coordinates in a spiral pattern with "radius" around "center".
+		template <class Type>
+		class SpiralRange : public Generated<Type, SpiralRange<Type>> {
+
+			friend class Generated<Type, SpiralRange<Type>>;
+
+			Type center;
+			unsigned radius;
+			unsigned ring_radius = 0;
+			unsigned index = 0;
+
+		public:
+
+			Type current;
+			bool valid = true;
+
+			SpiralRange(unsigned radius, const Type& center) : center(center), radius(radius), current(center) {}
+
+			unsigned size() const {
+				return 1 + 3 * radius * (radius + 1); // 1 + 6 * (1 + 2 + 3 + ...)
+			}
+
+		private:
+
+			bool advance() {
+				if (index == 6 * ring_radius) {
+					if (ring_radius == radius) return false;
+					ring_radius++;
+					index = 0;
+					current = center;
+					current.shift(Direction::West, ring_radius);
+				}
+				current.shift(static_cast<Direction>(index++ / ring_radius));
+				return true;
+			}
+
+		};
+
+		// Lazily calculates hexagonal coordinates in a rectangle pattern with "width" and "height" at "origin".
+		template <class Type>
+		class RectangleRange : public Generated<Type, RectangleRange<Type>> {
+
+			friend class Generated<Type, RectangleRange<Type>>;
+
+			Type origin;
+			unsigned width, height;
+			int u, v;
+			int u_begin, u_end;
+			int v_end;
+
+			static int offset(int v) {
+				return v / 2 - (v < 0 and is_odd(v));
+			}
+
+		public:
+
+			Type current;
+			bool valid;
+
+			RectangleRange(unsigned width, unsigned height, const Type& origin, bool centered = true) : origin(origin), width(width), height(height) {
+				valid = width != 0 and height != 0;
+				v = centered ? -static_cast<int>(height / 2) : 0;
+				v_end = v + height;
+				u_begin = centered ? -static_cast<int>(width / 2) : 0;
+				u_end = u_begin + width;
+				u = u_begin - offset(v);
+				if (valid) current = origin + Type(u, v);
+			}
+
+			unsigned size() const {
+				return valid ? width * height : 0;
+			}
+
+		private:
+
+			bool advance() {
+				if (++u == u_end - offset(v)) {
+					if (++v == v_end) return false;
+					u = u_begin - offset(v);
+				}
+				current = origin + Type(u, v);
+				return true;
+			}
+
+		};
+
+		// Lazily calculates hexagonal coordinates in a line between "begin" and "end" and allows to stop early.
+		template <class Type>
+		LineRange<Type> line_range(const Type& begin, const Type& end, bool supercover = false, bool edgecover = true) {
+			return LineRange<Type>(begin, end, supercover, edgecover);
+		}
+
+		// Lazily calculates hexagonal coordinates in a ring pattern with "radius" around "center".
+		template <class Type>
+		RingRange<Type> ring_range(unsigned radius, const Type& center) {
+			return RingRange<Type>(radius, center);
+		}
+
+		// Lazily calculates hexagonal coordinates in a spiral pattern with "radius" around "center".
+		template <class Type>
+		SpiralRange<Type> spiral_range(unsigned radius, const Type& center) {
+			return SpiralRange<Type>(radius, center);
+		}
+
+		// Lazily calculates hexagonal coordinates in a rectangle pattern with "width" and "height" at "origin".
+		template <class Type>
+		RectangleRange<Type> rectangle_range(unsigned width, unsigned height, const Type& origin, bool centered = true) {
+			return RectangleRange<Type>(width, height, origin, centered);
+		}
+
+	}
+
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+
+#include <hexagonal/Map.h>
+#include <hexagonal/Ranges.h>
+
+namespace tenjix {
+
+	namespace hexagonal {
+
+		// Elevations per cell indexed by Map::index, e.g. the heights written by the tile system.
+		struct TerrainElevations {
+
+			const Map* map;
+			const float* elevations;
+
+			TerrainElevations(const Map& map, const float* elevations) : map(&map), elevations(elevations) {}
+
+			float operator()(const Cell& coordinates) const {
+				return elevations[map->index(coordinates)];
+			}
+
+		};
+
+		// Calculates the cells visible from a viewer by shadow casting over the rings around it, where higher cells occlude the cells behind them.
+		// Elevations are provided by a callable "float(const Cell&)" and the viewer's eye is located "eye_height" above its own cell.
+		// Every ring only depends on the previous one, since hexagonal rings are scaled hexagons: the ray to a cell crosses the previous ring at the same relative position.
+		// All buffers are allocated once, so repeated queries don't allocate (except for growing the resulting lots).
+		// Visible cells are reprojected into the map, the radius should be less than half of the map width to avoid visiting cells twice.
+		class FieldOfView {
+
+			const Map* map;
+			unsigned maximum_radius;
+
+			// highest slope from the eye which is occluded at each position of the previous and current ring
+			Lot<float> previous_horizon;
+			Lot<float> current_horizon;
+
+			// cells of the previous result are marked with "stamp", those which are still visible with "stamp + 1"
+			Lot<unsigned> marks;
+			unsigned stamp = 0;
+
+			void begin_marking() {
+				stamp += 2;
+				if (stamp < 2) {
+					std::fill(marks.begin(), marks.end(), 0);
+					stamp = 2;
+				}
+			}
+
+		public:
+
+			FieldOfView(const Map& map, unsigned maximum_radius) : map(&map), maximum_radius(maximum_radius) {
+				previous_horizon.resize(6 * maximum_radius + 1);
+				current_horizon.resize(6 * maximum_radius + 1);
+				marks.resize(map.width() * map.height(), 0);
+			}
+
+			// calls "function" with all cells within "radius" visible from "viewer", ordered by their distance
+			template <class Elevations, class Function>
+			void each_visible(const Cell& viewer, unsigned radius, float eye_height, Elevations elevations, Function function) {
+				runtime_assert(radius <= maximum_radius, "the radius exceeds the maximum radius of the field of view");
+				if (not map->contains_vertically(viewer)) return;
+				Cell center = map->reproject(viewer);
+				float eye = elevations(center) + eye_height;
+				function(center);
+				previous_horizon[0] = std::numeric_limits<float>::lowest();
+				for (unsigned ring = 1; ring <= radius; ring++) {
+					unsigned previous_size = ring == 1 ? 1 : 6 * (ring - 1);
+					unsigned size = 6 * ring;
+					// the first cell of a ring is located one step after its west corner
+					unsigned position = 1;
+					for (auto& cell : ring_range(ring, center)) {
+						// position of the ray to this cell on the previous ring, interpolated between its two nearest cells
+						float previous_position = static_cast<float>(position * (ring - 1)) / ring;
+						unsigned before = static_cast<unsigned>(previous_position);
+						float fraction = previous_position - before;
+						float before_horizon = previous_horizon[before % previous_size];
+						float after_horizon = previous_horizon[(before + 1) % previous_size];
+						float horizon = before_horizon + fraction * (after_horizon - before_horizon);
+						if (map->contains_vertically(cell)) {
+							Cell reprojected = map->reproject(cell);
+							float slope = (elevations(reprojected) - eye) / ring;
+							if (not (slope < horizon)) function(reprojected);
+							horizon = maximum(horizon, slope);
+						}
+						current_horizon[position % size] = horizon;
+						position++;
+					}
+					std::swap(previous_horizon, current_horizon);
+				}
+			}
+
+			// calculates all cells within "radius" visible from "viewer"
+			template <class Elevations>
+			void compute(const Cell& viewer, unsigned radius, float eye_height, Elevations elevations, Lot<Cell>& visible) {
+				visible.clear();
+				each_visible(viewer, radius, eye_height, elevations, [&](const Cell& cell) {
+					visible.push_back(cell);
+				});
+			}
+
+			// recalculates the visible cells of a viewer which has moved (e.g. by one cell), "visible" has to contain the previous result
+			// cells that became visible are collected in "entered", cells that are no longer visible in "left"
+			// the field of view is calculated as a whole, since moving the eye changes its slope to every cell and thereby all horizons
+			template <class Elevations>
+			void recompute(const Cell& viewer, unsigned radius, float eye_height, Elevations elevations, Lot<Cell>& visible, Lot<Cell>& entered, Lot<Cell>& left) {
+				entered.clear();
+				left.clear();
+				begin_marking();
+				for (auto& cell : visible) {
+					marks[map->index(cell)] = stamp;
+				}
+				left.swap(visible);
+				visible.clear();
+				each_visible(viewer, radius, eye_height, elevations, [&](const Cell& cell) {
+					unsigned& mark = marks[map->index_unchecked(cell)];
+					if (mark != stamp) entered.push_back(cell);
+					mark = stamp + 1;
+					visible.push_back(cell);
+				});
+				left.erase(std::remove_if(left.begin(), left.end(), [&](const Cell& cell) {
+					return marks[map->index(cell)] != stamp;
+				}), left.end());
+			}
+
+			// counts the viewers which see each cell, "counts" is indexed by Map::index and accumulates the results of multiple calls
+			template <class Elevations, class Count>
+			void reveal(const Cell* viewers, std::size_t count, unsigned radius, float eye_height, Elevations elevations, Lot<Count>& counts) {
+				for (std::size_t viewer = 0; viewer < count; viewer++) {
+					each_visible(viewers[viewer], radius, eye_height, elevations, [&](const Cell& cell) {
+						counts[map->index_unchecked(cell)]++;
+					});
+				}
+			}
+
+			// counts the viewers which see each cell (see reveal)
+			template <class Elevations, class Count>
+			void reveal(const Lot<Cell>& viewers, unsigned radius, float eye_height, Elevations elevations, Lot<Count>& counts) {
+				reveal(viewers.data(), viewers.size(), radius, eye_height, elevations, counts);
+			}
+
+		};
+
+	}
+
+}
@@ -11,6 +11,8 @@
 #include <utilities/Properties.h>
 #include <utilities/Standard.h>
 
+#include <utilities/Logging.h>
+
 namespace tenjix {
 
 	namespace sethex {
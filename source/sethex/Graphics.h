@@ -2,7 +2,11 @@
 
 #include <cinder/app/AppBase.h>
 #include <cinder/gl/gl.h>
+#include <cinder/gl/Pbo.h>
 #include <cinder/gl/Ssbo.h>
+#include <cinder/gl/Sync.h>
+
+#include <sethex/Images.h>
 
 namespace tenjix {
 
@@ -16,12 +20,6 @@ namespace tenjix {
 
 		using ci::DataSource;
 		using ci::ImageSource;
-		using ci::Surface;
-		using ci::Surface8u;
-		using ci::Surface32f;
-		using ci::Channel;
-		using ci::Channel8u;
-		using ci::Channel32f;
 
 		using ci::app::Window;
 		using ci::app::FileDropEvent;
@@ -45,6 +43,8 @@ namespace tenjix {
 		using VertexBuffer = ci::gl::Vbo;
 		using FrameBuffer = ci::gl::Fbo;
 		using ShaderBuffer = ci::gl::Ssbo;
+		using PixelBuffer = ci::gl::Pbo;
+		using Fence = ci::gl::Sync;
 
 	}
 
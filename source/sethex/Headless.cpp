@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifndef SETHEX_WITHOUT_CINDER
+#include <cinder/ImageIo.h>
+#endif
+
+#include <utilities/Exceptions.h>
+
+#include <sethex/world/Generation.h>
+
+using namespace cinder;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Generates a world without a window or graphics context by running the CPU stages of the generator and writes its maps to disk.
+		// Parallel processes can generate batches of worlds, e.g. with different seeds and output directories.
+		// Builds without Cinder (SETHEX_WITHOUT_CINDER) write the maps as binary netpbm images (PGM and PPM) instead of PNG.
+		class Headless {
+
+			WorldParameters parameters;
+			bool high_resolution = false;
+			fs::path output = "exported";
+
+			const char* usage =
+				"usage: Headless [options]\n"
+				"  --preset <name>        applies a preset of the generator, e.g. \"Alpha World\"\n"
+				"  --parameters <file>    reads lines of \"name = value\" after the preset, e.g. \"sealevel = 0.25\"\n"
+				"  --seed <seed>          overrides the seed of the preset and the parameters\n"
+				"  --high-resolution      generates 1600 x 900 instead of 800 x 450 pixels\n"
+				"  --output <directory>   directory of the maps (default \"exported\")\n";
+
+			// maps the elevation [-1, +1] to 16 bit with the sea level at 0.5, like the elevation maps read by the generator
+			static Channel16u quantize_elevation(const Channel32f& elevation_map) {
+				Channel16u quantized(elevation_map.getWidth(), elevation_map.getHeight());
+				auto elevation_iterator = elevation_map.getIter();
+				auto quantized_iterator = quantized.getIter();
+				while (elevation_iterator.line() and quantized_iterator.line()) {
+					while (elevation_iterator.pixel() and quantized_iterator.pixel()) {
+						float elevation = clamp(elevation_iterator.v(), -1.0f, 1.0f);
+						quantized_iterator.v() = static_cast<uint16_t>((elevation + 1.0f) / 2.0f * 65535.0f + 0.5f);
+					}
+				}
+				return quantized;
+			}
+
+		#ifdef SETHEX_WITHOUT_CINDER
+			static void write_netpbm(const fs::path& path, const char* format, unsigned maximum, int width, int height, const Lot<uint8>& bytes) {
+				ofstream stream(path.string(), ios::binary);
+				stream << format << '\n' << width << ' ' << height << '\n' << maximum << '\n';
+				stream.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+				if (not stream) throw_runtime_exception("couldn't write '", path, "'");
+			}
+
+			// 16 bit values are stored most significant byte first
+			static void write_map(const fs::path& path, const Channel16u& map) {
+				Lot<uint8> bytes;
+				auto iterator = map.getIter();
+				while (iterator.line()) while (iterator.pixel()) {
+					bytes.push_back(static_cast<uint8>(iterator.v() >> 8));
+					bytes.push_back(static_cast<uint8>(iterator.v()));
+				}
+				write_netpbm(path.string() + ".pgm", "P5", 65535, map.getWidth(), map.getHeight(), bytes);
+			}
+
+			static void write_map(const fs::path& path, const Channel& map) {
+				Lot<uint8> bytes;
+				auto iterator = map.getIter();
+				while (iterator.line()) while (iterator.pixel()) bytes.push_back(iterator.v());
+				write_netpbm(path.string() + ".pgm", "P5", 255, map.getWidth(), map.getHeight(), bytes);
+			}
+
+			static void write_map(const fs::path& path, const Surface& map) {
+				Lot<uint8> bytes;
+				auto iterator = map.getIter();
+				while (iterator.line()) while (iterator.pixel()) {
+					bytes.insert(bytes.end(), { iterator.r(), iterator.g(), iterator.b() });
+				}
+				write_netpbm(path.string() + ".ppm", "P6", 255, map.getWidth(), map.getHeight(), bytes);
+			}
+		#else
+			template<class Map>
+			static void write_map(const fs::path& path, const Map& map) {
+				writeImage(path.string() + ".png", map);
+			}
+		#endif
+
+		public:
+
+			// returns false if only the usage has been requested
+			bool parse(int argc, char* argv[]) {
+				String preset, parameter_file, seed;
+				for (int index = 1; index < argc; index++) {
+					String argument = argv[index];
+					auto value = [&]() -> String {
+						if (index + 1 >= argc) throw_runtime_exception("missing value of '", argument, "'");
+						return argv[++index];
+					};
+					if (argument == "--preset") preset = value();
+					else if (argument == "--parameters") parameter_file = value();
+					else if (argument == "--seed") seed = value();
+					else if (argument == "--high-resolution") high_resolution = true;
+					else if (argument == "--output") output = value();
+					else if (argument == "--help") {
+						cout << usage;
+						return false;
+					} else throw_runtime_exception("unknown argument '", argument, "'\n", usage);
+				}
+				if (not preset.empty()) {
+					auto& presets = WorldParameters::preset_list;
+					auto found = find(presets.begin(), presets.end(), preset);
+					if (found == presets.end()) throw_runtime_exception("unknown preset '", preset, "'");
+					// the elevation of the earth is composed of elevation maps by a shader
+					if (preset == "Earth") throw_runtime_exception("the preset '", preset, "' needs a graphics context");
+					parameters.apply_preset(static_cast<unsigned>(found - presets.begin()), high_resolution);
+				}
+				if (not parameter_file.empty()) {
+					ifstream stream(parameter_file);
+					if (not stream) throw_runtime_exception("can't open parameters '", parameter_file, "'");
+					parameters.read(stream);
+				}
+				if (not seed.empty()) parameters.seed = stoi(seed);
+				return true;
+			}
+
+			void generate() {
+				unsigned2 resolution = high_resolution ? unsigned2(1600, 900) : unsigned2(800, 450);
+				ElevationSection section;
+				section.size = signed2(resolution);
+				section.full_resolution = resolution;
+				Simplex::Generator simplex;
+				simplex.seed(parameters.seed);
+				Simplex::Batch batch(simplex);
+				BiomeClassifier classifier(parameters.get_biome_determination(), [this](uint8 temperature) { return parameters.normalize_temperature(temperature); });
+
+				GenerationMaps maps;
+				Job job;
+				job.stage("Tectonic", [&](Job& job) { generate_elevation(parameters, batch, section, job, maps); });
+				job.stage("Topography", [&](Job& job) { generate_topography(parameters, simplex, resolution, 1, job, maps); });
+				job.stage("Climate", [&](Job& job) { generate_linear_climate(parameters, resolution, job, maps); });
+				job.stage("Biomes", [&](Job& job) { classify_biomes(classifier, resolution, job, maps); });
+				job.start();
+				job.wait();
+
+				double seconds = 0.0;
+				for (unsigned stage = 0; stage < job.stage_count(); stage++) {
+					cout << job.stage_name(stage) << ": " << fixed << setprecision(1) << job.stage_seconds(stage) * 1000.0 << " ms" << endl;
+					seconds += job.stage_seconds(stage);
+				}
+				cout << "Generation: " << fixed << setprecision(1) << seconds * 1000.0 << " ms" << endl;
+				float water_percentage = 100.0f * maps.water_pixels / (resolution.x * resolution.y);
+				cout << water_percentage << "% Water, " << 100.0f - water_percentage << "% Land" << endl;
+
+				fs::create_directories(output);
+				write_map(output / "Elevation", quantize_elevation(*maps.elevation_map));
+				write_map(output / "Temperature", *maps.temperature_map);
+				write_map(output / "Precipitation", *maps.precipitation_map);
+				write_map(output / "Biome", *maps.biome_map);
+				cout << "Maps written to " << output << endl;
+			}
+
+		};
+
+	}
+
+}
+
+int main(int argc, char* argv[]) {
+	try {
+		tenjix::sethex::Headless headless;
+		if (headless.parse(argc, argv)) headless.generate();
+	} catch (const exception& exception) {
+		cerr << exception.what() << endl;
+		return 1;
+	}
+	return 0;
+}
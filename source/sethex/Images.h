@@ -0,0 +1,28 @@
+#pragma once
+
+#ifdef SETHEX_WITHOUT_CINDER
+#include <sethex/StandaloneImages.h>
+#else
+#include <cinder/Channel.h>
+#include <cinder/Color.h>
+#include <cinder/Filesystem.h>
+#include <cinder/Surface.h>
+#endif
+
+#include <sethex/Common.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// maps of the world generation, which don't need a graphics context, unlike the types of Graphics.h
+		using ci::Surface;
+		using ci::Surface8u;
+		using ci::Surface32f;
+		using ci::Channel;
+		using ci::Channel8u;
+		using ci::Channel32f;
+
+	}
+
+}
@@ -0,0 +1,63 @@
+#include "Jobs.h"
+
+#include <chrono>
+
+#include <utilities/Exceptions.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		Job::~Job() {
+			cancel();
+			if (thread.joinable()) thread.join();
+		}
+
+		Job& Job::stage(String name, Work work) {
+			if (launched) throw_runtime_exception("stages can't be appended to a started job");
+			stages.emplace_back(new Stage());
+			stages.back()->name = std::move(name);
+			stages.back()->work = std::move(work);
+			return *this;
+		}
+
+		void Job::start() {
+			if (launched) throw_runtime_exception("job has already been started");
+			launched = true;
+			thread = std::thread(&Job::run, this);
+		}
+
+		void Job::wait() {
+			if (thread.joinable()) thread.join();
+			rethrow();
+		}
+
+		bool Job::progress(float fraction) {
+			if (current < stages.size()) stages[current]->progress = fraction;
+			return not cancelling;
+		}
+
+		void Job::run() {
+			using clock = std::chrono::steady_clock;
+			for (unsigned index = 0; index < stages.size() and not cancelling; index++) {
+				auto& stage = *stages[index];
+				current = index;
+				auto start = clock::now();
+				try {
+					stage.work(*this);
+				} catch (...) {
+					// the remaining stages would depend on the maps of the failed one
+					exception = std::current_exception();
+					stage.seconds = std::chrono::duration<double>(clock::now() - start).count();
+					break;
+				}
+				stage.seconds = std::chrono::duration<double>(clock::now() - start).count();
+				if (not cancelling) stage.progress = 1.0f;
+			}
+			current = static_cast<unsigned>(stages.size());
+			done = true;
+		}
+
+	}
+
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include <sethex/Common.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Runs consecutive stages of work on a background thread, e.g. to keep the render thread responsive while a world is generated.
+		// Stages report their progress and check for cancellation between chunks of their work, the owner polls for completion.
+		// Stages may use the thread pool, but shouldn't write to data which is read by other threads before the job has finished.
+		// An exception of a stage ends the job, it's kept until the owner rethrows it on its own thread.
+		class Job {
+
+		public:
+
+			using Work = std::function<void(Job&)>;
+
+		private:
+
+			struct Stage {
+				String name;
+				Work work;
+				std::atomic<float> progress { 0.0f };
+				std::atomic<double> seconds { 0.0 };
+			};
+
+			Lot<std::unique_ptr<Stage>> stages;
+			std::atomic<unsigned> current { 0 };
+			std::atomic<bool> cancelling { false };
+			std::atomic<bool> done { false };
+			// exception of the failed stage, which is only accessed once the job has finished
+			std::exception_ptr exception;
+			bool launched = false;
+			std::thread thread;
+
+			void run();
+
+		public:
+
+			Job() = default;
+
+			// cancels the job and waits for the running stage to return
+			~Job();
+
+			Job(const Job&) = delete;
+			Job& operator=(const Job&) = delete;
+
+			// appends a stage, which is only possible before the job has been started
+			Job& stage(String name, Work work);
+
+			// runs the stages in the order they were appended on a new thread
+			void start();
+
+			// asks the running stage to return early and skips the remaining stages
+			void cancel() {
+				cancelling = true;
+			}
+
+			bool cancelled() const {
+				return cancelling;
+			}
+
+			bool started() const {
+				return launched;
+			}
+
+			// blocks until all stages have returned, e.g. to run a job without a render loop, and rethrows the exception of a failed stage
+			void wait();
+
+			// whether all stages have returned, which happens early if the job has been cancelled or a stage has failed
+			bool finished() const {
+				return done;
+			}
+
+			// whether a stage has thrown an exception, which ended the job
+			bool failed() const {
+				return done and exception;
+			}
+
+			// rethrows the exception of the failed stage on the calling thread, e.g. to report it on the render thread
+			void rethrow() const {
+				if (failed()) std::rethrow_exception(exception);
+			}
+
+			// reports the progress [0, 1] of the running stage, returns false if the stage should return early
+			bool progress(float fraction);
+
+			unsigned stage_count() const {
+				return static_cast<unsigned>(stages.size());
+			}
+
+			// index of the running stage, which equals the number of stages once the job has finished
+			unsigned current_stage() const {
+				return current;
+			}
+
+			const String& stage_name(unsigned stage) const {
+				return stages[stage]->name;
+			}
+
+			float stage_progress(unsigned stage) const {
+				return stages[stage]->progress;
+			}
+
+			// seconds spent in a stage, which is measured once the stage has returned
+			double stage_seconds(unsigned stage) const {
+				return stages[stage]->seconds;
+			}
+
+		};
+
+	}
+
+}
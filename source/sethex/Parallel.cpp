@@ -0,0 +1,119 @@
+#include "Parallel.h"
+
+namespace tenjix {
+
+	namespace sethex {
+
+		ThreadPool::ThreadPool(unsigned threads) {
+			for (unsigned index = 0; index < threads; index++) {
+				queues.emplace_back(new Queue());
+			}
+			for (unsigned index = 0; index < threads; index++) {
+				workers.emplace_back(&ThreadPool::work, this, index);
+			}
+		}
+
+		ThreadPool::~ThreadPool() {
+			{
+				std::lock_guard<std::mutex> lock(sleeping);
+				stopping = true;
+			}
+			wake_up.notify_all();
+			for (auto& worker : workers) {
+				worker.join();
+			}
+		}
+
+		ThreadPool& ThreadPool::instance() {
+			static ThreadPool pool;
+			return pool;
+		}
+
+		void ThreadPool::submit(Task task) {
+			if (queues.empty()) {
+				task();
+				return;
+			}
+			auto& queue = *queues[next_queue++ % queues.size()];
+			{
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				queue.tasks.push_back(std::move(task));
+			}
+			{
+				// prevents the notification from getting lost between checking for tasks and sleeping
+				std::lock_guard<std::mutex> lock(sleeping);
+				queued++;
+			}
+			wake_up.notify_one();
+		}
+
+		void ThreadPool::Completion::fail(std::exception_ptr exception) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (not failure) failure = exception;
+			failed = true;
+		}
+
+		void ThreadPool::Completion::finish() {
+			// notifies while holding the lock, since the waiting thread destroys the completion once it sees the last task finish
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--remaining == 0) finished.notify_all();
+		}
+
+		void ThreadPool::Completion::wait(ThreadPool& pool) {
+			while (pool.help()) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (remaining == 0) break;
+			}
+			std::unique_lock<std::mutex> lock(mutex);
+			finished.wait(lock, [this]() { return remaining == 0; });
+			if (failure) std::rethrow_exception(failure);
+		}
+
+		bool ThreadPool::pop(unsigned queue, Task& task) {
+			auto& own = *queues[queue];
+			std::lock_guard<std::mutex> lock(own.mutex);
+			if (own.tasks.empty()) return false;
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			queued--;
+			return true;
+		}
+
+		bool ThreadPool::steal(unsigned thief, Task& task) {
+			unsigned count = static_cast<unsigned>(queues.size());
+			for (unsigned offset = 1; offset <= count; offset++) {
+				auto& victim = *queues[(thief + offset) % count];
+				std::lock_guard<std::mutex> lock(victim.mutex);
+				if (victim.tasks.empty()) continue;
+				task = std::move(victim.tasks.front());
+				victim.tasks.pop_front();
+				queued--;
+				return true;
+			}
+			return false;
+		}
+
+		bool ThreadPool::help() {
+			Task task;
+			if (queues.empty() or not steal(0, task)) return false;
+			task();
+			return true;
+		}
+
+		void ThreadPool::work(unsigned queue) {
+			Task task;
+			while (true) {
+				if (pop(queue, task) or steal(queue, task)) {
+					task();
+					task = nullptr;
+					continue;
+				}
+				std::unique_lock<std::mutex> lock(sleeping);
+				wake_up.wait(lock, [this]() { return stopping or queued > 0; });
+				if (stopping) return;
+			}
+		}
+
+	}
+
+}
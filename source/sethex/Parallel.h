@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <utilities/Mathematics.h>
+
+#include <sethex/Common.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Runs tasks on a fixed number of worker threads with one queue per worker.
+		// Workers take their own tasks from the back and steal tasks of other workers from the front once they run dry.
+		// Threads waiting for tasks (see parallel_for) help with pending tasks and block once there are none left to take.
+		class ThreadPool {
+
+			using Task = std::function<void()>;
+
+			struct Queue {
+				std::mutex mutex;
+				std::deque<Task> tasks;
+			};
+
+			Lot<std::unique_ptr<Queue>> queues;
+			Lot<std::thread> workers;
+			std::atomic<unsigned> next_queue { 0 };
+			std::atomic<int> queued { 0 };
+			std::mutex sleeping;
+			std::condition_variable wake_up;
+			bool stopping = false;
+
+			// counts the running tasks of a parallel_for and keeps the first exception thrown by one of them
+			class Completion {
+
+				std::mutex mutex;
+				std::condition_variable finished;
+				int remaining;
+				std::atomic<bool> failed { false };
+				std::exception_ptr failure;
+
+			public:
+
+				explicit Completion(int tasks) : remaining(tasks) {}
+
+				// runs the task unless another one has failed already, an exception is passed on to the waiting thread
+				template <class Function>
+				void run(Function&& task) {
+					try {
+						if (not failed) task();
+					} catch (...) {
+						fail(std::current_exception());
+					}
+					finish();
+				}
+
+				void fail(std::exception_ptr exception);
+				void finish();
+				// helps with pending tasks of "pool" until there are none, blocks until all tasks have finished and rethrows the first failure
+				void wait(ThreadPool& pool);
+
+			};
+
+			bool pop(unsigned queue, Task& task);
+			bool steal(unsigned thief, Task& task);
+			void work(unsigned queue);
+
+		public:
+
+			// creates one worker per hardware thread, except for the thread which creates the pool
+			explicit ThreadPool(unsigned threads = maximum(std::thread::hardware_concurrency(), 2u) - 1);
+
+			~ThreadPool();
+
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			// shared pool of the application, which is created on first use
+			static ThreadPool& instance();
+
+			// number of worker threads
+			unsigned size() const {
+				return static_cast<unsigned>(workers.size());
+			}
+
+			// queues a task, which is distributed round-robin among the workers and must not throw (see parallel_for)
+			void submit(Task task);
+
+			// runs a single pending task on the calling thread, returns false if there was none
+			bool help();
+
+			// calls "function" for each index in [begin, end), which is split into tasks of "grain" consecutive indices
+			// the calling thread participates and returns once all indices have been processed
+			// the first exception thrown by "function" is rethrown on the calling thread, after which the remaining tasks are skipped
+			template <class Function>
+			void parallel_for(int begin, int end, int grain, Function function) {
+				if (begin >= end) return;
+				grain = maximum(grain, 1);
+				int tasks = (end - begin + grain - 1) / grain;
+				if (tasks == 1 or workers.empty()) {
+					for (int index = begin; index < end; index++) function(index);
+					return;
+				}
+				Completion completion(tasks);
+				for (int first = begin; first < end; first += grain) {
+					int last = minimum(first + grain, end);
+					submit([&function, &completion, first, last]() {
+						completion.run([&]() {
+							for (int index = first; index < last; index++) function(index);
+						});
+					});
+				}
+				completion.wait(*this);
+			}
+
+		};
+
+	}
+
+}
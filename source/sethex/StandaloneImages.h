@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Subset of the image types of Cinder, which the CPU stages use without a graphics context.
+// It's used instead of Cinder by builds without it (SETHEX_WITHOUT_CINDER), e.g. the headless generator and the tests.
+// The maps own their pixels or wrap foreign ones, like those of Cinder, and are copied deeply.
+namespace cinder {
+
+	namespace fs = std::filesystem;
+
+	template<typename T>
+	class ColorT {
+
+	public:
+
+		T r = 0, g = 0, b = 0;
+
+		ColorT() = default;
+		ColorT(T r, T g, T b) : r(r), g(g), b(b) {}
+
+		bool operator==(const ColorT& other) const {
+			return r == other.r and g == other.g and b == other.b;
+		}
+
+		bool operator!=(const ColorT& other) const {
+			return not operator==(other);
+		}
+
+	};
+
+	template<typename T>
+	class ColorAT {
+
+	public:
+
+		T r = 0, g = 0, b = 0, a = 0;
+
+		ColorAT() = default;
+		ColorAT(T r, T g, T b, T a) : r(r), g(g), b(b), a(a) {}
+
+		operator ColorT<T>() const {
+			return { r, g, b };
+		}
+
+	};
+
+	using Color8u = ColorT<uint8_t>;
+	using ColorA8u = ColorAT<uint8_t>;
+
+	// rows of "width" pixels of "increment" values, which are "row_bytes" apart
+	template<typename T>
+	class ImageData {
+
+	protected:
+
+		int32_t width = 0;
+		int32_t height = 0;
+		ptrdiff_t row_bytes = 0;
+		uint8_t increment = 1;
+		std::shared_ptr<T> data;
+
+		ImageData(int32_t width, int32_t height, uint8_t increment)
+			: width(width), height(height), row_bytes(width * increment * sizeof(T)), increment(increment),
+			data(new T[static_cast<size_t>(width) * height * increment](), std::default_delete<T[]>()) {
+		}
+
+		ImageData(int32_t width, int32_t height, ptrdiff_t row_bytes, uint8_t increment, T* pixels)
+			: width(width), height(height), row_bytes(row_bytes), increment(increment), data(pixels, [](T*) {}) {
+		}
+
+		ImageData(const ImageData& other) : ImageData(other.width, other.height, other.increment) {
+			for (int32_t row = 0; row < height; row++) {
+				std::copy(other.getData(glm::ivec2(0, row)), other.getData(glm::ivec2(0, row)) + width * increment, getData(glm::ivec2(0, row)));
+			}
+		}
+
+		ImageData& operator=(const ImageData& other) {
+			ImageData copy(other);
+			std::swap(width, copy.width);
+			std::swap(height, copy.height);
+			std::swap(row_bytes, copy.row_bytes);
+			std::swap(increment, copy.increment);
+			std::swap(data, copy.data);
+			return *this;
+		}
+
+	public:
+
+		// iterates the rows with line() and their pixels with pixel(), which both start before the first one
+		template<typename Value>
+		class Iterator {
+
+			uint8_t* first;
+			ptrdiff_t row_bytes;
+			uint8_t increment;
+			int32_t width, height;
+			int32_t column = -1, row = -1;
+
+		protected:
+
+			Value* pointer() const {
+				return reinterpret_cast<Value*>(first + row * row_bytes) + column * increment;
+			}
+
+		public:
+
+			Iterator(Value* data, ptrdiff_t row_bytes, uint8_t increment, int32_t width, int32_t height)
+				: first(reinterpret_cast<uint8_t*>(const_cast<T*>(data))), row_bytes(row_bytes), increment(increment), width(width), height(height) {
+			}
+
+			bool line() {
+				column = -1;
+				return ++row < height;
+			}
+
+			bool pixel() {
+				return ++column < width;
+			}
+
+			int32_t x() const { return column; }
+			int32_t y() const { return row; }
+			glm::ivec2 getPos() const { return { column, row }; }
+			int32_t getWidth() const { return width; }
+			int32_t getHeight() const { return height; }
+
+		};
+
+		int32_t getWidth() const { return width; }
+		int32_t getHeight() const { return height; }
+		glm::ivec2 getSize() const { return { width, height }; }
+		ptrdiff_t getRowBytes() const { return row_bytes; }
+
+		T* getData() { return data.get(); }
+		const T* getData() const { return data.get(); }
+
+		T* getData(const glm::ivec2& offset) {
+			return reinterpret_cast<T*>(reinterpret_cast<uint8_t*>(data.get()) + offset.y * row_bytes) + offset.x * increment;
+		}
+
+		const T* getData(const glm::ivec2& offset) const {
+			return const_cast<ImageData*>(this)->getData(offset);
+		}
+
+	};
+
+	template<typename T>
+	class ChannelT : public ImageData<T> {
+
+		using ImageData<T>::width;
+		using ImageData<T>::height;
+		using ImageData<T>::row_bytes;
+		using ImageData<T>::increment;
+
+	public:
+
+		template<typename Value>
+		class Iterator : public ImageData<T>::template Iterator<Value> {
+
+		public:
+
+			using ImageData<T>::template Iterator<Value>::Iterator;
+
+			Value& v() const {
+				return *this->pointer();
+			}
+
+		};
+
+		using Iter = Iterator<T>;
+		using ConstIter = Iterator<const T>;
+
+		ChannelT() : ImageData<T>(0, 0, 1) {}
+		ChannelT(int32_t width, int32_t height) : ImageData<T>(width, height, 1) {}
+		// wraps foreign pixels, which have to outlive the channel
+		ChannelT(int32_t width, int32_t height, ptrdiff_t row_bytes, uint8_t increment, T* pixels) : ImageData<T>(width, height, row_bytes, increment, pixels) {}
+
+		static std::shared_ptr<ChannelT> create(int32_t width, int32_t height) {
+			return std::make_shared<ChannelT>(width, height);
+		}
+
+		static std::shared_ptr<ChannelT> create(const ChannelT& other) {
+			return std::make_shared<ChannelT>(other);
+		}
+
+		uint8_t getIncrement() const { return increment; }
+
+		T getValue(glm::ivec2 position) const {
+			position = glm::ivec2(std::min(std::max(position.x, 0), width - 1), std::min(std::max(position.y, 0), height - 1));
+			return *this->getData(position);
+		}
+
+		void setValue(const glm::ivec2& position, T value) {
+			*this->getData(position) = value;
+		}
+
+		Iter getIter() { return Iter(this->getData(), row_bytes, increment, width, height); }
+		ConstIter getIter() const { return ConstIter(this->getData(), row_bytes, increment, width, height); }
+
+	};
+
+	// channel orders of a surface, only RGB and RGBA are supported
+	class SurfaceChannelOrder {
+
+	public:
+
+		enum { RGBA, RGB = 6 };
+
+	};
+
+	template<typename T>
+	class SurfaceT : public ImageData<T> {
+
+		using ImageData<T>::width;
+		using ImageData<T>::height;
+		using ImageData<T>::row_bytes;
+		using ImageData<T>::increment;
+
+	public:
+
+		template<typename Value>
+		class Iterator : public ImageData<T>::template Iterator<Value> {
+
+		public:
+
+			using ImageData<T>::template Iterator<Value>::Iterator;
+
+			Value& r() const { return this->pointer()[0]; }
+			Value& g() const { return this->pointer()[1]; }
+			Value& b() const { return this->pointer()[2]; }
+			Value& a() const { return this->pointer()[3]; }
+
+		};
+
+		using Iter = Iterator<T>;
+		using ConstIter = Iterator<const T>;
+
+		SurfaceT() : ImageData<T>(0, 0, 3) {}
+		SurfaceT(int32_t width, int32_t height, bool alpha, int order = SurfaceChannelOrder::RGB) : ImageData<T>(width, height, alpha ? 4 : 3) {}
+
+		static std::shared_ptr<SurfaceT> create(int32_t width, int32_t height, bool alpha, int order = SurfaceChannelOrder::RGB) {
+			return std::make_shared<SurfaceT>(width, height, alpha, order);
+		}
+
+		static std::shared_ptr<SurfaceT> create(const SurfaceT& other) {
+			return std::make_shared<SurfaceT>(other);
+		}
+
+		bool hasAlpha() const { return increment == 4; }
+		uint8_t getPixelInc() const { return increment; }
+
+		ColorAT<T> getPixel(glm::ivec2 position) const {
+			position = glm::ivec2(std::min(std::max(position.x, 0), width - 1), std::min(std::max(position.y, 0), height - 1));
+			auto pixel = this->getData(position);
+			return { pixel[0], pixel[1], pixel[2], hasAlpha() ? pixel[3] : T(255) };
+		}
+
+		Iter getIter() { return Iter(this->getData(), row_bytes, increment, width, height); }
+		ConstIter getIter() const { return ConstIter(this->getData(), row_bytes, increment, width, height); }
+
+	};
+
+	using Channel = ChannelT<uint8_t>;
+	using Channel8u = ChannelT<uint8_t>;
+	using Channel16u = ChannelT<uint16_t>;
+	using Channel32f = ChannelT<float>;
+	using Surface = SurfaceT<uint8_t>;
+	using Surface8u = SurfaceT<uint8_t>;
+	using Surface32f = SurfaceT<float>;
+
+}
+
+namespace ci = cinder;
@@ -14,12 +14,15 @@ namespace tenjix {
 
 			Property<bool, Instantiable> active;
 			SharedProperty<Batch, Instantiable> batch;
+			// number of instances rendered per entity
+			Property<uint, Instantiable> instances;
 
-			Instantiable(const shared<Batch>& batch = nullptr) : active(true), batch(batch) {
+			Instantiable(const shared<Batch>& batch = nullptr) : active(true), batch(batch), instances(1) {
 				this->active.owner = this;
 				//this->active.attach([this]() { notify(); });
 				this->batch.owner = this;
 				//this->batch.attach([this]() { notify(); });
+				this->instances.owner = this;
 			}
 
 			static shared<Instantiable> create(const shared<Batch>& batch = nullptr) {
@@ -1,22 +1,60 @@
 #pragma once
 
 #include <hexagonal/Coordinates.h>
+#include <hexagonal/Grid.h>
 
+#include <sethex/Common.h>
 #include <sethex/EntitySystem.h>
+#include <sethex/Graphics.h>
 
 namespace tenjix {
 
 	namespace sethex {
 
-		class Tile : public Component {
+		// Describes a single tile of the tile map.
+		class Tile {
 
 		public:
 
-			hex::Coordinates coordinates;
+			hex::Cell coordinates;
+			float3 position;
 			const char* biome = "";
 
 		};
 
+		// Per tile attributes of a map chunk, stored in contiguous columns and indexed by hex::Chunks::local_index.
+		// The coordinates aren't stored, since hex::Chunks::cell derives them from the chunk and the index.
+		// A single entity holds all tiles of a chunk, which are rendered as instances of one mesh.
+		class Tiles : public Component, public hex::Grid<float3, float, uint8, float3, float, float, uint16, uint8> {
+
+		public:
+
+			enum Column : unsigned { Position, Elevation, Biome, Color, Temperature, Precipitation, Owner, Flags };
+
+			// instance buffers of the positions and colors
+			shared<VertexBuffer> instance_positions;
+			shared<VertexBuffer> instance_colors;
+
+			Lot<float3>& positions() { return column<Position>(); }
+			Lot<float>& elevations() { return column<Elevation>(); }
+			Lot<uint8>& biomes() { return column<Biome>(); }
+			Lot<float3>& colors() { return column<Color>(); }
+			Lot<float>& temperatures() { return column<Temperature>(); }
+			Lot<float>& precipitations() { return column<Precipitation>(); }
+			Lot<uint16>& owners() { return column<Owner>(); }
+			Lot<uint8>& flags() { return column<Flags>(); }
+
+			const Lot<float3>& positions() const { return column<Position>(); }
+			const Lot<float>& elevations() const { return column<Elevation>(); }
+			const Lot<uint8>& biomes() const { return column<Biome>(); }
+			const Lot<float3>& colors() const { return column<Color>(); }
+			const Lot<float>& temperatures() const { return column<Temperature>(); }
+			const Lot<float>& precipitations() const { return column<Precipitation>(); }
+			const Lot<uint16>& owners() const { return column<Owner>(); }
+			const Lot<uint8>& flags() const { return column<Flags>(); }
+
+		};
+
 	}
 
 }
@@ -127,7 +127,7 @@ namespace tenjix {
 				ui::ScopedWindow ui_window("Menu", ImGuiWindowFlags_NoTitleBar);
 				ui::Checkbox("Background", &render_background);
 				if (ui::Checkbox("World", &render_world)) {
-					world.get<TileSystem>().get_entities().begin()->get<Instantiable>().active = render_world;
+					world.get<TileSystem>().show(render_world);
 				}
 				if (ui::Checkbox("Entity", &render_entity)) {
 					auto entity = world.find_entity("test-object");
@@ -159,8 +159,13 @@ namespace tenjix {
 				update_world |= resize_world;
 				update_world |= ui::SliderFloat("Elevation Scale", scale, 0.1f, 10.0f, "%.2f", 3.45f, 1.0f);
 				update_world |= ui::SliderFloat("Elevation Power", power, 0.1f, 10.0f, "%.2f", 3.45f, 1.0f);
+				// a loaded world replaces the tiles right away
+				update_world |= generator.loaded;
+				generator.loaded = false;
 				if (update_world) {
-					world.get<TileSystem>().update(generator.biomes, generator.elevation, scale, power);
+					if (generator.archive) world.get<TileSystem>().update(generator.archive, scale, power);
+					else if (generator.snapshot) world.get<TileSystem>().update(*generator.snapshot, scale, power);
+					else world.get<TileSystem>().update(generator.biomes, generator.elevation, generator.biome_colors, scale, power);
 				}
 			}
 
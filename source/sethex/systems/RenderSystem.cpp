@@ -10,7 +10,7 @@ namespace tenjix {
 	namespace sethex {
 
 		void RenderSystem::render() {
-			trace("==================== render ====================");
+			TENJIX_TRACE("==================== render ====================");
 			Display& display = world->find_entity("Main Display").get<Display>();
 			render(display);
 		}
@@ -95,7 +95,7 @@ namespace tenjix {
 				auto entity = *entities.begin();
 				auto& material = entity.get<Material>();
 				material.bind_textures();
-				instantiable.instantiate(entities.size());
+				instantiable.instantiate(entities.size() * instantiable.instances);
 				material.unbind_textures();
 			}
 
@@ -153,7 +153,10 @@ namespace tenjix {
 		void RenderSystem::unmap(const Entity& entity, const linked<Shader>& shader, const linked<Material>& material, const linked<Mesh>& mesh) {
 			auto instantiable = entity.get_shared<Instantiable>();
 			if (instantiable) {
-				instantiables[instantiable.get()].erase(entity);
+				auto& entities = instantiables[instantiable.get()];
+				entities.erase(entity);
+				// instantiables of removed entities (e.g. evicted tile chunks) may be released afterwards
+				if (entities.empty()) instantiables.erase(instantiable.get());
 			} else {
 				//entity_mapping[shader][material][mesh].erase(entity);
 				uninstantiables.erase(entity);
@@ -6,9 +6,13 @@
 #include <cinder/utilities/Shaders.h>
 #include <cinder/utilities/Watchdog.h>
 
+#include <hexagonal/Batch.h>
+#include <hexagonal/Ranges.h>
+
 #include <sethex/components/Display.h>
 #include <sethex/components/Geometry.h>
-#include <sethex/world/Generator.h>
+#include <sethex/world/Archive.h>
+#include <sethex/world/Snapshot.h>
 
 using namespace std;
 using namespace cinder;
@@ -25,16 +29,28 @@ namespace tenjix {
 
 		signed2 mouse_down_position;
 
-		void TileSystem::mark(const Lot<hex::Coordinates>& coordinates) {
-			float3* mapped_instance_colors = static_cast<float3*>(instance_colors->mapWriteOnly());
+		void TileSystem::mark(const Lot<hex::Cell>& coordinates) {
 			float3 color(0.15f);
 			for (auto& c : coordinates) {
-				mapped_instance_colors[map.index(c)] = color;
+				auto chunk = chunks.find(chunks.chunk_of(c));
+				if (not chunk) continue;
+				chunk->get<Tiles>().instance_colors->bufferSubData(chunks.local_index(c) * sizeof(float3), sizeof(float3), &color);
 			}
-			instance_colors->unmap();
 		}
 
-		optional<Entity> TileSystem::get_tile(float2 mouse_position) const {
+		optional<Tile> TileSystem::tile(const hex::Cell& coordinates) const {
+			auto chunk = chunks.peek(chunks.chunk_of(coordinates));
+			if (not chunk) return {};
+			auto& tiles = chunk->get<Tiles>();
+			auto index = chunks.local_index(coordinates);
+			Tile tile;
+			tile.coordinates = map.reproject(coordinates);
+			tile.position = tiles.positions()[index];
+			tile.biome = get_biome_name(tiles.biomes()[index]);
+			return tile;
+		}
+
+		optional<Tile> TileSystem::get_tile(float2 mouse_position) const {
 			Display& display = world->find_entity("Main Display").get<Display>();
 			Ray ray = display.camera.generateRay(mouse_position, display.size);
 			float distance;
@@ -42,12 +58,13 @@ namespace tenjix {
 			if (hit_ground) {
 				auto ground_position = ray.calcPosition(distance);
 				auto camera_position = display.camera.getEyePoint();
-				auto line = Coordinates::line(Coordinates::of(camera_position), Coordinates::of(ground_position), true);
+				auto line = line_range(Cell::of(camera_position), Cell::of(ground_position), true);
 				auto extrusion = float3(0, hexagon_extrusion / 2, 0);
 				for (auto& coordinates : line) {
-					auto tile = tiles[map.index(coordinates)];
-					auto position = tile.get<Geometry>().position() + extrusion;
-					//debug("check ", tile, " ", coordinates, " ", position);
+					auto tile = this->tile(coordinates);
+					if (not tile) continue;
+					auto position = tile->position + extrusion;
+					//debug("check ", coordinates, " ", position);
 					bool hit_elevation = ray.calcPlaneIntersection(position, float3(0, 1, 0), &distance);
 					if (not hit_elevation) continue;
 					auto intersection = ray.calcPosition(distance);
@@ -62,15 +79,22 @@ namespace tenjix {
 		}
 
 		void TileSystem::focus(const hex::Coordinates& coordinates) {
-			auto tile = tiles[map.index(coordinates)];
-			focus(tile);
+			chunks.acquire(chunks.chunk_of(coordinates));
+			focus(*tile(coordinates));
 		}
 
-		void TileSystem::focus(const Entity& tile) {
-			auto position = tile.get<Geometry>().position() + float3(0, hexagon_extrusion / 2, 0);
+		void TileSystem::focus(const Tile& tile) {
+			auto position = tile.position + float3(0, hexagon_extrusion / 2, 0);
 			focus(position);
 		}
 
+		void TileSystem::show(bool visible) {
+			this->visible = visible;
+			chunks.each([visible](unsigned chunk, Entity& entity) {
+				entity.get<Instantiable>().active = visible;
+			});
+		}
+
 		void TileSystem::focus(const float3& position) {
 			previous_focus_coordinates = focus_coordinates;
 			previous_focus_position = target_focus_position;
@@ -95,6 +119,8 @@ namespace tenjix {
 				}
 			}
 
+			hexagon_mesh = TriMesh(Extrude(hexagon_shape, hexagon_extrusion) >> Rotate(quaternion(float3(-Pi_Half, 0.0f, 0.0f))));
+
 			// create material and mesh
 
 			//String vertex_shader = loadString(loadAsset("shaders/Tile.vertex.shader"));
@@ -115,10 +141,6 @@ namespace tenjix {
 			material->name("Shared Tile Material");
 			//material->add(hexagon_texure);
 
-			// make tiles instantiable
-
-			instantiable = Instantiable::create();
-
 			wd::watch("shaders/Material.*", [this](const fs::path& path) {
 				String vertex_shader = loadString(loadAsset("shaders/Material.vertex.shader"));
 				shader::define(vertex_shader, "INSTANTIATION");
@@ -130,11 +152,9 @@ namespace tenjix {
 					return;
 				}
 				material->shader->setLabel("Tile Shader");
-				if (not mesh) return;
-				Batch::AttributeMapping attributes;
-				attributes.emplace(Attrib::CUSTOM_0, "InstancePosition");
-				attributes.emplace(Attrib::CUSTOM_1, "InstanceColor");
-				instantiable->batch = Batch::create(mesh, material->shader, attributes);
+				chunks.each([this](unsigned chunk, Entity& entity) {
+					entity.get<Instantiable>().batch = create_batch(entity.get<Geometry>().mesh());
+				});
 			});
 
 			resize({ 16, 9 });
@@ -143,8 +163,8 @@ namespace tenjix {
 				auto mouse_position = event.getPos();
 				auto tile = get_tile(mouse_position);
 				if (tile) {
-					if (event.isAltDown()) mark({ tile->get<Tile>().coordinates });
-					selected_tile = tile->get<Tile>();
+					if (event.isAltDown()) mark({ tile->coordinates });
+					selected_tile = tile;
 				} else {
 					selected_tile = {};
 				}
@@ -251,8 +271,6 @@ namespace tenjix {
 			});
 		}
 
-		float3* mapped_instance_positions;
-
 		void TileSystem::update(float delta_time) {
 			Display& display = world->find_entity("Main Display").get<Display>();
 			if (display.minimized()) return;
@@ -276,114 +294,177 @@ namespace tenjix {
 
 			static Coordinates previous_focus_coordinates;
 			if (focus_coordinates != previous_focus_coordinates) {
-				mapped_instance_positions = static_cast<float3*>(instance_positions->mapWriteOnly());
+				chunks.retain(chunks.chunks_around(focus_coordinates, residency_radius));
 				System::update(delta_time);
-				instance_positions->unmap();
 			}
 			previous_focus_coordinates = focus_coordinates;
 		}
 
 		void TileSystem::update(Entity& entity, float delta_time) {
-			auto geometry = entity.get_shared<Geometry>();
-			if (not geometry) return;
-			auto& tile = entity.get<Tile>();
-			auto& position = geometry->position();
-			if (not focus_range.contains(position.x)) {
-				position.x += map.width * UnitHexagon.width * sign(focus_position.x - position.x);
-				mapped_instance_positions[map.index(tile.coordinates)] = position;
+			auto& tiles = entity.get<Tiles>();
+			float map_width = map.width * UnitHexagon.width;
+			float3* mapped_instance_positions = nullptr;
+			for (unsigned index = 0; index < tiles.size(); index++) {
+				auto& position = tiles.positions()[index];
+				if (not focus_range.contains(position.x)) {
+					position.x += map_width * sign(focus_position.x - position.x);
+					if (not mapped_instance_positions) mapped_instance_positions = static_cast<float3*>(tiles.instance_positions->mapWriteOnly());
+					mapped_instance_positions[index] = position;
+				}
 			}
+			if (mapped_instance_positions) tiles.instance_positions->unmap();
 		}
 
-		void TileSystem::resize(unsigned2 size) {
-
-			// build map coordinates
-
-			map = hex::Map(size.x, size.y);
-			tiles.reserve(map.coordinates().size());
-
-			vector<float3> positions;
-			vector<float3> colors;
-			positions.reserve(map.coordinates().size());
-			colors.reserve(map.coordinates().size());
-			for (auto& coordinates : map.coordinates()) {
-				positions.push_back(coordinates.to_position());
-				colors.push_back(glm::mix(float3(1.0), coordinates.to_floats(), 0.25));
+		// moves the positions of "tiles" by whole map widths into the focus range
+		void TileSystem::wrap_positions(Tiles& tiles) const {
+			float map_width = map.width * UnitHexagon.width;
+			for (auto& position : tiles.positions()) {
+				position.x += map_width * round((focus_position.x - position.x) / map_width);
 			}
-			instance_positions = VertexBuffer::create(GL_ARRAY_BUFFER, positions, GL_DYNAMIC_DRAW);
-			instance_colors = VertexBuffer::create(GL_ARRAY_BUFFER, colors, GL_DYNAMIC_DRAW);
-
-			mesh = Mesh::create(Extrude(hexagon_shape, hexagon_extrusion) >> Rotate(quaternion(float3(-Pi_Half, 0.0f, 0.0f))));
-			mesh->appendVbo(BufferLayout({ { Attrib::CUSTOM_0, 3, 0, 0, 1 } }), instance_positions);
-			mesh->appendVbo(BufferLayout({ { Attrib::CUSTOM_1, 3, 0, 0, 1 } }), instance_colors);
+		}
 
+		shared<Batch> TileSystem::create_batch(const shared<Mesh>& mesh) const {
 			Batch::AttributeMapping attributes;
 			attributes.emplace(Attrib::CUSTOM_0, "InstancePosition");
 			attributes.emplace(Attrib::CUSTOM_1, "InstanceColor");
-			instantiable->batch = Batch::create(mesh, material->shader, attributes);
-
-			// create entities
+			return Batch::create(mesh, material->shader, attributes);
+		}
 
-			for (auto tile : tiles) {
-				world->destroy_entity(tile);
+		Entity TileSystem::generate_chunk(unsigned chunk) {
+			auto cells = chunks.cells(chunk);
+			auto tiles = make_shared<Tiles>();
+			tiles->resize(static_cast<unsigned>(cells.size()));
+
+			auto& positions = tiles->positions();
+			auto& colors = tiles->colors();
+			batch::to_positions(cells.data(), positions.data(), tiles->size());
+			wrap_positions(*tiles);
+			for (unsigned index = 0; index < tiles->size(); index++) {
+				colors[index] = glm::mix(float3(1.0), cells[index].to_floats(), 0.25);
 			}
-			tiles.clear();
+			apply_maps(chunk, *tiles);
+			tiles->instance_positions = VertexBuffer::create(GL_ARRAY_BUFFER, positions, GL_DYNAMIC_DRAW);
+			tiles->instance_colors = VertexBuffer::create(GL_ARRAY_BUFFER, colors, GL_DYNAMIC_DRAW);
 
-			print("generate tiles");
-			auto start = chrono::system_clock::now();
+			auto mesh = Mesh::create(hexagon_mesh);
+			mesh->appendVbo(BufferLayout({ { Attrib::CUSTOM_0, 3, 0, 0, 1 } }), tiles->instance_positions);
+			mesh->appendVbo(BufferLayout({ { Attrib::CUSTOM_1, 3, 0, 0, 1 } }), tiles->instance_colors);
+
+			auto instantiable = Instantiable::create(create_batch(mesh));
+			instantiable->instances = tiles->size();
+			instantiable->active = visible;
 
-			auto coordinate_iterator = map.coordinates().begin();
-			auto position_iterator = positions.begin();
-			world->create_entities(map.coordinates().size(), "Tile #", [&](Entity entity) {
-				entity.add<Tile>().coordinates = *coordinate_iterator++;
-				entity.add<Geometry>().mesh(mesh).position(*position_iterator++);
+			return world->create_entity(stringify("Tile Chunk #", chunk), [&](Entity entity) {
+				entity.add(tiles);
+				entity.add<Geometry>().mesh(mesh);
 				entity.add(material);
 				entity.add(instantiable);
-				tiles.push_back(entity);
 			});
+		}
+
+		void TileSystem::resize(unsigned2 size) {
+
+			// build map, whose coordinates are enumerated per chunk
+
+			chunks.clear();
+			map = hex::Map(size.x, size.y, false);
+			chunks = hex::Chunks<Entity>(map, chunk_capacity);
+			chunks.generate = [this](unsigned chunk) {
+				return generate_chunk(chunk);
+			};
+			chunks.evict = [this](unsigned chunk, Entity& entity) {
+				world->destroy_entity(entity);
+			};
+
+			focus_expansion = (map.width / 2 + 1) * UnitHexagon.size.x;
+			focus_range = { focus_position.x - focus_expansion, focus_position.x + focus_expansion };
+
+			// generate the chunks around the focus
+
+			print("generate tiles");
+			auto start = chrono::system_clock::now();
+
+			chunks.retain(chunks.chunks_around(focus_coordinates, residency_radius));
 
 			auto end = chrono::system_clock::now();
-			print("tiles generated");
+			print(chunks.size(), " of ", chunks.count(), " chunks generated");
 			auto duration = end - start;
 			print("in ", chrono::duration_cast<chrono::milliseconds>(duration).count(), " milliseconds");
 
-			focus_expansion = (map.width / 2 + 1) * UnitHexagon.size.x;
 			print(map.width, "x", map.height);
 		}
 
-		float3* mapped_instance_colors;
-
-		void TileSystem::update(shared<Surface> biome_map, shared<Channel32f> elevation_map, float scale, float power) {
+		// samples the elevation and biome maps at the positions of the tiles of "chunk"
+		void TileSystem::apply_maps(unsigned chunk, Tiles& tiles) const {
+			if (not elevation_map and not biome_map and not biome_ids and not archive) return;
 			float2 biome_map_size, elevation_map_size;
-			if (elevation_map) {
-				mapped_instance_positions = static_cast<float3*>(instance_positions->mapReplace());
-				elevation_map_size = elevation_map->getSize();
-			}
-			if (biome_map) {
-				mapped_instance_colors = static_cast<float3*>(instance_colors->mapReplace());
-				biome_map_size = biome_map->getSize();
-			}
-			if (elevation_map or biome_map) {
-				scale *= glm::length(map.cartesian_size()) * 0.02f;
-				for (auto& entity : get_entities()) {
-					auto& tile = entity.get<Tile>();
-					auto& coordinates = tile.coordinates;
-					auto& position = entity.get<Geometry>().position();
-					auto texinates = map.texinates(coordinates);
-					if (elevation_map) {
-						auto elevation = *elevation_map->getData(elevation_map_size * texinates);
-						position.y = (pow(elevation + 1.0f, power) - 1.0f) * scale;
-						mapped_instance_positions[map.index(coordinates)] = position;
-					}
-					if (biome_map) {
-						auto biome = biome_map->getPixel(biome_map_size * texinates);
-						tile.biome = Generator::get_biome_name(biome);
-						float3 color(biome.r, biome.g, biome.b);
-						mapped_instance_colors[map.index(coordinates)] = color / 255.0f;
-					}
+			if (elevation_map) elevation_map_size = elevation_map->getSize();
+			if (biome_map) biome_map_size = biome_map->getSize();
+			if (biome_ids) biome_map_size = biome_ids->getSize();
+			if (archive) elevation_map_size = biome_map_size = float2(archive->get_size());
+			float scale = elevation_scale * glm::length(map.cartesian_size()) * 0.02f;
+			for (unsigned index = 0; index < tiles.size(); index++) {
+				auto texinates = map.texinates(chunks.cell(chunk, index));
+				if (elevation_map or archive) {
+					auto& elevation = tiles.elevations()[index];
+					// the archive decodes the chunks of the sampled pixels, which are close to each other for the tiles of a chunk
+					elevation = archive ? archive->get_elevation(signed2(elevation_map_size * texinates)) : *elevation_map->getData(elevation_map_size * texinates);
+					tiles.positions()[index].y = (pow(elevation + 1.0f, elevation_power) - 1.0f) * scale;
+				}
+				if (biome_map) {
+					auto biome = biome_map->getPixel(biome_map_size * texinates);
+					tiles.biomes()[index] = biome_colors.get_id(biome);
+					tiles.colors()[index] = float3(biome.r, biome.g, biome.b) / 255.0f;
+				} else if (biome_ids or archive) {
+					auto biome_id = archive ? archive->get_biome_id(signed2(biome_map_size * texinates)) : biome_ids->getValue(biome_map_size * texinates);
+					auto biome = biome_colors.get_color(biome_id);
+					tiles.biomes()[index] = biome_id;
+					tiles.colors()[index] = float3(biome.r, biome.g, biome.b) / 255.0f;
 				}
 			}
-			if (elevation_map) instance_positions->unmap();
-			if (biome_map) instance_colors->unmap();
+		}
+
+		void TileSystem::update(shared<Surface> biome_map, shared<Channel32f> elevation_map, const BiomeColors& biome_colors, float scale, float power) {
+			this->biome_map = biome_map;
+			this->elevation_map = elevation_map;
+			this->biome_colors = biome_colors;
+			biome_ids = nullptr;
+			archive = nullptr;
+			elevation_scale = scale;
+			elevation_power = power;
+			apply_maps();
+		}
+
+		void TileSystem::update(const WorldSnapshot& snapshot, float scale, float power) {
+			biome_map = nullptr;
+			biome_ids = snapshot.get_biome_ids();
+			elevation_map = snapshot.get_elevation_map();
+			archive = nullptr;
+			biome_colors = snapshot.get_parameters().biome_colors;
+			elevation_scale = scale;
+			elevation_power = power;
+			apply_maps();
+		}
+
+		void TileSystem::update(shared<WorldArchive> archive, float scale, float power) {
+			biome_map = nullptr;
+			biome_ids = nullptr;
+			elevation_map = nullptr;
+			this->archive = archive;
+			biome_colors = archive->get_parameters().biome_colors;
+			elevation_scale = scale;
+			elevation_power = power;
+			apply_maps();
+		}
+
+		// samples the maps at the tiles of all resident chunks and uploads their positions and colors
+		void TileSystem::apply_maps() {
+			chunks.each([this](unsigned chunk, Entity& entity) {
+				auto& tiles = entity.get<Tiles>();
+				apply_maps(chunk, tiles);
+				if (elevation_map or archive) tiles.instance_positions->copyData(tiles.size() * sizeof(float3), tiles.positions().data());
+				if (biome_map or biome_ids or archive) tiles.instance_colors->copyData(tiles.size() * sizeof(float3), tiles.colors().data());
+			});
 		}
 
 	}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <hexagonal/Chunks.h>
 #include <hexagonal/Map.h>
 
 #include <sethex/Common.h>
@@ -7,17 +8,37 @@
 #include <sethex/components/Instantiable.h>
 #include <sethex/components/Material.h>
 #include <sethex/components/Tile.h>
+#include <sethex/world/Biomes.h>
 
 namespace tenjix {
 
 	namespace sethex {
 
+		class WorldArchive;
+		class WorldSnapshot;
+
 		//using namespace tenjix;
 
 		class TileSystem : public System {
 
 			hex::Map map;
-			Lot<Entity> tiles;
+			// entities of the resident chunks, each rendering the tiles of one chunk
+			hex::Chunks<Entity> chunks;
+			// number of columns and rows around the focus whose chunks are kept resident
+			unsigned residency_radius = 128;
+			unsigned chunk_capacity = 32;
+			bool visible = true;
+
+			shared<Surface> biome_map;
+			// compact biome ids, which replace the biome map, e.g. of a world snapshot
+			shared<Channel> biome_ids;
+			// compressed maps, whose chunks are decoded once tiles sample them
+			shared<WorldArchive> archive;
+			shared<Channel32f> elevation_map;
+			// colors of the biome map, which convert between colors and compact ids
+			BiomeColors biome_colors;
+			float elevation_scale = 1.0f;
+			float elevation_power = 1.0f;
 
 			bool focusing = false;
 
@@ -25,15 +46,17 @@ namespace tenjix {
 			float focus_expansion;
 			Range<float> focus_range;
 
-			shared<VertexBuffer> instance_positions;
-			shared<VertexBuffer> instance_colors;
-
 			ci::Shape2d hexagon_shape;
+			ci::TriMesh hexagon_mesh;
 			float hexagon_extrusion = 5.0;
 
-			shared<Instantiable> instantiable;
 			shared<Material> material;
-			shared<Mesh> mesh;
+
+			Entity generate_chunk(unsigned chunk);
+			shared<Batch> create_batch(const shared<Mesh>& mesh) const;
+			void apply_maps(unsigned chunk, Tiles& tiles) const;
+			void wrap_positions(Tiles& tiles) const;
+			void apply_maps();
 
 		public:
 
@@ -44,10 +67,10 @@ namespace tenjix {
 			optional<Tile> selected_tile;
 
 			TileSystem() : System(1) {
-				filter.required_types.insert<Tile>();
+				filter.required_types.insert<Tiles>();
 			}
 
-			void mark(const Lot<hex::Coordinates>& coordinates);
+			void mark(const Lot<hex::Cell>& coordinates);
 
 			void initialize() override;
 			void update(float delta_time) override;
@@ -55,16 +78,24 @@ namespace tenjix {
 
 			void resize(unsigned2 size);
 
-			void update(shared<Surface> biome_map = nullptr, shared<Channel32f> elevation_map = nullptr, float scale = 1.0, float power = 1.0);
-			void update(shared<ImageSource> biome_map = nullptr, shared<ImageSource> elevation_map = nullptr, float scale = 1.0, float power = 1.0) {
+			// "biome_colors" are the colors the biome map was classified with
+			void update(shared<Surface> biome_map = nullptr, shared<Channel32f> elevation_map = nullptr, const BiomeColors& biome_colors = {}, float scale = 1.0, float power = 1.0);
+			void update(shared<ImageSource> biome_map = nullptr, shared<ImageSource> elevation_map = nullptr, const BiomeColors& biome_colors = {}, float scale = 1.0, float power = 1.0) {
 				if (not biome_map or not elevation_map) return;
-				update(Surface::create(biome_map), Channel32f::create(elevation_map), scale, power);
+				update(Surface::create(biome_map), Channel32f::create(elevation_map), biome_colors, scale, power);
 			}
+			// the layers of the snapshot are sampled from its memory mapping
+			void update(const WorldSnapshot& snapshot, float scale = 1.0, float power = 1.0);
+			// only the chunks of the archive below the resident tiles are decoded, also by the tiles generated later on
+			void update(shared<WorldArchive> archive, float scale = 1.0, float power = 1.0);
+
+			void show(bool visible);
 
-			optional<Entity> get_tile(float2 mouse_position) const;
+			optional<Tile> tile(const hex::Cell& coordinates) const;
+			optional<Tile> get_tile(float2 mouse_position) const;
 
 			void focus(const hex::Coordinates& coordinates);
-			void focus(const Entity& tile);
+			void focus(const Tile& tile);
 			void focus(const float3& position);
 
 		};
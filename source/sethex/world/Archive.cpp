@@ -0,0 +1,364 @@
+#include "Archive.h"
+
+#include <chrono>
+#include <limits>
+#include <sstream>
+
+#include <utilities/Exceptions.h>
+#include <utilities/Mathematics.h>
+
+using namespace cinder;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		namespace {
+
+			const char Archive_Signature[4] = { 'S', 'X', 'W', 'A' };
+
+			// LZ codec of sequences of literals followed by a match of previous bytes, like LZ4
+			// a token holds the number of literals and the length of the match, which are continued by bytes of 255 if they exceed 15
+			namespace lz {
+
+				const size_t Minimum_Match = 4;
+				const size_t Maximum_Offset = 65535;
+				const unsigned Hash_Bits = 12;
+
+				uint32 read32(const uint8* data) {
+					return data[0] | data[1] << 8 | data[2] << 16 | static_cast<uint32>(data[3]) << 24;
+				}
+
+				void write_length(Lot<uint8>& output, size_t length) {
+					for (; length >= 255; length -= 255) output.push_back(255);
+					output.push_back(static_cast<uint8>(length));
+				}
+
+				// the last sequence consists of literals only
+				void write_sequence(Lot<uint8>& output, const uint8* literals, size_t literal_length, size_t match_length, size_t offset) {
+					size_t match_code = match_length ? match_length - Minimum_Match : 0;
+					output.push_back(static_cast<uint8>(min<size_t>(literal_length, 15) << 4 | min<size_t>(match_code, 15)));
+					if (literal_length >= 15) write_length(output, literal_length - 15);
+					output.insert(output.end(), literals, literals + literal_length);
+					if (not match_length) return;
+					output.push_back(static_cast<uint8>(offset));
+					output.push_back(static_cast<uint8>(offset >> 8));
+					if (match_code >= 15) write_length(output, match_code - 15);
+				}
+
+				void compress(const uint8* input, size_t size, Lot<uint8>& output) {
+					output.clear();
+					// positions + 1 of the last occurrence of the hashed 4 bytes
+					Lot<size_t> last_positions(size_t(1) << Hash_Bits, 0);
+					size_t position = 0, literal_start = 0;
+					while (position + Minimum_Match <= size) {
+						uint32 sequence = read32(input + position);
+						uint32 hash = (sequence * 2654435761u) >> (32 - Hash_Bits);
+						size_t candidate = last_positions[hash];
+						last_positions[hash] = position + 1;
+						if (candidate and position - (candidate - 1) <= Maximum_Offset and read32(input + candidate - 1) == sequence) {
+							size_t match = candidate - 1;
+							size_t length = Minimum_Match;
+							while (position + length < size and input[match + length] == input[position + length]) length++;
+							write_sequence(output, input + literal_start, position - literal_start, length, position - match);
+							position += length;
+							literal_start = position;
+						} else {
+							position++;
+						}
+					}
+					write_sequence(output, input + literal_start, size - literal_start, 0, 0);
+				}
+
+				// returns false if "input" doesn't decode to exactly "size" bytes
+				bool decompress(const uint8* input, size_t input_size, uint8* output, size_t size) {
+					const uint8* end = input + input_size;
+					size_t position = 0;
+					auto read_length = [&](size_t length) {
+						if (length < 15) return length;
+						for (uint8 byte = 255; byte == 255 and input < end; length += byte) byte = *input++;
+						return length;
+					};
+					while (input < end) {
+						uint8 token = *input++;
+						size_t literal_length = read_length(token >> 4);
+						if (literal_length > static_cast<size_t>(end - input) or literal_length > size - position) return false;
+						copy(input, input + literal_length, output + position);
+						input += literal_length;
+						position += literal_length;
+						if (input == end) break;
+						if (end - input < 2) return false;
+						size_t offset = input[0] | input[1] << 8;
+						input += 2;
+						size_t match_length = read_length(token & 15) + Minimum_Match;
+						if (offset == 0 or offset > position or match_length > size - position) return false;
+						// the match may overlap the bytes it produces
+						for (size_t index = 0; index < match_length; index++, position++) output[position] = output[position - offset];
+					}
+					return position == size;
+				}
+
+			}
+
+			// the elevation [-1, +1] is quantized to 16 bit
+			int16 quantize(float elevation) {
+				return static_cast<int16>(round(clamp(elevation, -1.0f, 1.0f) * 32767.0f));
+			}
+
+			// interleaves positive and negative deltas, so small ones have a zero high byte
+			uint16 zigzag(int16 delta) {
+				return static_cast<uint16>(static_cast<uint16>(delta) << 1 ^ static_cast<uint16>(delta >> 15));
+			}
+
+			int16 unzigzag(uint16 value) {
+				return static_cast<int16>(value >> 1 ^ (0 - (value & 1)));
+			}
+
+			// whether "size" bytes from "offset" end before "end", without overflowing
+			bool fits(uint64 offset, uint64 size, uint64 end) {
+				return offset <= end and size <= end - offset;
+			}
+
+			// determines the size of a chunk, which is smaller at the right and bottom border of the map, and its first pixel
+			signed2 chunk_extent(const WorldArchive::Header& header, unsigned columns, unsigned chunk, signed2& origin) {
+				int size = header.chunk_size;
+				origin = signed2(chunk % columns * size, chunk / columns * size);
+				return signed2(min<int>(size, header.width - origin.x), min<int>(size, header.height - origin.y));
+			}
+
+		}
+
+		// definitions of the constants, which are bound to references by the messages of exceptions
+		const uint32 WorldArchive::Version;
+		const unsigned WorldArchive::Maximum_Chunk_Size;
+
+		void WorldArchive::write(const fs::path& path, const WorldParameters& parameters, const Channel32f& elevation_map, const Channel& temperature_map,
+			const Channel& precipitation_map, const Surface& biome_map, unsigned chunk_size) {
+			signed2 size = elevation_map.getSize();
+			if (temperature_map.getSize() != size or precipitation_map.getSize() != size or biome_map.getSize() != size) throw_runtime_exception("the maps of a world archive differ in size");
+			if (chunk_size == 0 or chunk_size > Maximum_Chunk_Size) throw_runtime_exception("invalid chunk size ", chunk_size, " of a world archive");
+			ostringstream parameter_lines;
+			parameters.write(parameter_lines);
+			String parameter_text = parameter_lines.str();
+
+			if (path.has_parent_path()) fs::create_directories(path.parent_path());
+			ofstream stream(path.string(), ios::binary);
+			if (not stream) throw_runtime_exception("can't create world archive '", path, "'");
+
+			Header header = {};
+			copy(begin(Archive_Signature), end(Archive_Signature), header.signature);
+			header.version = Version;
+			header.width = size.x;
+			header.height = size.y;
+			header.chunk_size = chunk_size;
+			header.layer_count = Layer_Count;
+			header.parameters_offset = sizeof(header);
+			header.parameters_size = parameter_text.size();
+			header.index_offset = header.parameters_offset + header.parameters_size;
+			unsigned columns = (size.x + chunk_size - 1) / chunk_size;
+			unsigned rows = (size.y + chunk_size - 1) / chunk_size;
+			Lot<Index> index(columns * rows * Layer_Count);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			stream.write(parameter_text.data(), parameter_text.size());
+			// the index is written again once the chunks are compressed
+			stream.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(Index));
+
+			Lot<uint8> raw, compressed;
+			for (unsigned chunk = 0; chunk < columns * rows; chunk++) {
+				signed2 origin;
+				signed2 extent = chunk_extent(header, columns, chunk, origin);
+				size_t pixels = extent.x * extent.y;
+				for (unsigned layer = 0; layer < Layer_Count; layer++) {
+					// elevations are delta coded as 16 bit and split into planes of their low and high bytes, the climate is delta coded as 8 bit
+					raw.resize(layer == Elevation ? pixels * 2 : pixels);
+					size_t pixel = 0;
+					for (int row = 0; row < extent.y; row++) {
+						signed2 start = origin + signed2(0, row);
+						if (layer == Elevation) {
+							auto elevations = elevation_map.getData(start);
+							int16 previous = row > 0 ? quantize(*elevation_map.getData(start - signed2(0, 1))) : 0;
+							for (int column = 0; column < extent.x; column++, pixel++) {
+								int16 elevation = quantize(elevations[column]);
+								uint16 delta = zigzag(static_cast<int16>(elevation - previous));
+								raw[pixel] = static_cast<uint8>(delta);
+								raw[pixels + pixel] = static_cast<uint8>(delta >> 8);
+								previous = elevation;
+							}
+						} else if (layer == Temperature or layer == Precipitation) {
+							auto values = (layer == Temperature ? temperature_map : precipitation_map).getData(start);
+							uint8 previous = 0;
+							for (int column = 0; column < extent.x; column++, pixel++) {
+								raw[pixel] = static_cast<uint8>(values[column] - previous);
+								previous = values[column];
+							}
+						} else {
+							for (int column = 0; column < extent.x; column++, pixel++) {
+								raw[pixel] = parameters.biome_colors.get_id(biome_map.getPixel(start + signed2(column, 0)));
+							}
+						}
+					}
+					lz::compress(raw.data(), raw.size(), compressed);
+					index[chunk * Layer_Count + layer] = { static_cast<uint64>(stream.tellp()), compressed.size() };
+					stream.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+				}
+			}
+
+			stream.seekp(header.index_offset);
+			stream.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(Index));
+			if (not stream) throw_runtime_exception("couldn't write world archive '", path, "'");
+		}
+
+		WorldArchive::WorldArchive(const fs::path& path)
+			: stream(path.string(), ios::binary) {
+			if (not stream) throw_runtime_exception("can't open world archive '", path, "'");
+			stream.seekg(0, ios::end);
+			uint64 file_size = static_cast<uint64>(stream.tellg());
+			stream.seekg(0);
+			stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+			if (not stream or not equal(begin(Archive_Signature), end(Archive_Signature), header.signature)) throw_runtime_exception("'", path, "' isn't a world archive");
+			if (header.version != Version) throw_runtime_exception("world archive '", path, "' has version ", header.version, " instead of ", Version);
+			// the pixels are addressed by ints
+			uint32 maximum_extent = numeric_limits<int32>::max();
+			bool valid = header.layer_count == Layer_Count and header.width > 0 and header.height > 0 and header.width <= maximum_extent and header.height <= maximum_extent
+				and header.chunk_size > 0 and header.chunk_size <= Maximum_Chunk_Size;
+			if (not valid) throw_runtime_exception("world archive '", path, "' is invalid");
+			// the index is bounded by the file before it's allocated, so neither its size nor the keys of its chunks overflow
+			uint64 chunk_count = static_cast<uint64>((header.width + header.chunk_size - 1) / header.chunk_size) * ((header.height + header.chunk_size - 1) / header.chunk_size);
+			valid = fits(header.parameters_offset, header.parameters_size, file_size) and chunk_count * Layer_Count <= file_size / sizeof(Index)
+				and fits(header.index_offset, chunk_count * Layer_Count * sizeof(Index), file_size);
+			if (not valid) throw_runtime_exception("world archive '", path, "' is truncated");
+			columns = (header.width + header.chunk_size - 1) / header.chunk_size;
+			rows = (header.height + header.chunk_size - 1) / header.chunk_size;
+			String parameter_text(static_cast<size_t>(header.parameters_size), '\0');
+			stream.seekg(header.parameters_offset);
+			stream.read(&parameter_text[0], parameter_text.size());
+			index.resize(static_cast<size_t>(chunk_count * Layer_Count));
+			stream.seekg(header.index_offset);
+			stream.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(Index));
+			if (not stream) throw_runtime_exception("world archive '", path, "' is truncated");
+			for (auto& location : index) {
+				if (not fits(location.offset, location.size, file_size)) throw_runtime_exception("world archive '", path, "' is truncated");
+			}
+			istringstream parameter_lines(parameter_text);
+			parameters.read(parameter_lines);
+		}
+
+		void WorldArchive::decode(Layer layer, unsigned chunk, Decoded& result) {
+			auto& location = index[chunk * Layer_Count + layer];
+			compressed.resize(location.size);
+			stream.clear();
+			stream.seekg(location.offset);
+			stream.read(reinterpret_cast<char*>(compressed.data()), compressed.size());
+			signed2 origin;
+			signed2 extent = chunk_extent(header, columns, chunk, origin);
+			size_t pixels = extent.x * extent.y;
+			auto& raw = result.values;
+			raw.resize(layer == Elevation ? pixels * 2 : pixels);
+			if (not stream or not lz::decompress(compressed.data(), compressed.size(), raw.data(), raw.size())) {
+				throw_runtime_exception("chunk ", chunk, " of layer ", layer, " of the world archive is corrupt");
+			}
+			decoded_count++;
+			if (layer == Elevation) {
+				result.elevations.resize(pixels);
+				size_t pixel = 0;
+				int16 row_start = 0;
+				for (int row = 0; row < extent.y; row++) {
+					int16 elevation = row_start;
+					for (int column = 0; column < extent.x; column++, pixel++) {
+						elevation += unzigzag(static_cast<uint16>(raw[pixel] | raw[pixels + pixel] << 8));
+						result.elevations[pixel] = elevation / 32767.0f;
+						if (column == 0) row_start = elevation;
+					}
+				}
+				raw.clear();
+			} else if (layer == Temperature or layer == Precipitation) {
+				for (size_t row_start = 0; row_start < pixels; row_start += extent.x) {
+					for (size_t pixel = row_start + 1; pixel < row_start + extent.x; pixel++) raw[pixel] += raw[pixel - 1];
+				}
+			}
+		}
+
+		const WorldArchive::Decoded& WorldArchive::decode(Layer layer, unsigned chunk) {
+			unsigned key = chunk * Layer_Count + layer;
+			auto found = decoded.find(key);
+			if (found != decoded.end()) {
+				usage.splice(usage.begin(), usage, found->second.usage);
+				return found->second;
+			}
+			// a corrupt chunk throws before it's inserted, so the decoded chunks remain intact
+			Decoded values;
+			decode(layer, chunk, values);
+			if (decoded.size() >= capacity) {
+				decoded.erase(usage.back());
+				usage.pop_back();
+			}
+			usage.push_front(key);
+			values.usage = usage.begin();
+			return decoded.emplace(key, move(values)).first->second;
+		}
+
+		unsigned WorldArchive::locate(signed2& pixel) const {
+			int size = header.chunk_size;
+			pixel.x = clamp(pixel.x, 0, static_cast<int>(header.width) - 1);
+			pixel.y = clamp(pixel.y, 0, static_cast<int>(header.height) - 1);
+			unsigned chunk = pixel.x / size + pixel.y / size * columns;
+			pixel.x %= size;
+			pixel.y %= size;
+			return chunk;
+		}
+
+		float WorldArchive::get_elevation(signed2 pixel) {
+			unsigned chunk = locate(pixel);
+			signed2 origin;
+			return decode(Elevation, chunk).elevations[pixel.y * chunk_extent(header, columns, chunk, origin).x + pixel.x];
+		}
+
+		uint8 WorldArchive::get_temperature(signed2 pixel) {
+			unsigned chunk = locate(pixel);
+			signed2 origin;
+			return decode(Temperature, chunk).values[pixel.y * chunk_extent(header, columns, chunk, origin).x + pixel.x];
+		}
+
+		uint8 WorldArchive::get_precipitation(signed2 pixel) {
+			unsigned chunk = locate(pixel);
+			signed2 origin;
+			return decode(Precipitation, chunk).values[pixel.y * chunk_extent(header, columns, chunk, origin).x + pixel.x];
+		}
+
+		uint8 WorldArchive::get_biome_id(signed2 pixel) {
+			unsigned chunk = locate(pixel);
+			signed2 origin;
+			return decode(Biome_Ids, chunk).values[pixel.y * chunk_extent(header, columns, chunk, origin).x + pixel.x];
+		}
+
+		void WorldArchive::set_capacity(unsigned chunks) {
+			capacity = max(chunks, 1u);
+			while (decoded.size() > capacity) {
+				decoded.erase(usage.back());
+				usage.pop_back();
+			}
+		}
+
+		uint64 WorldArchive::get_compressed_size() const {
+			uint64 size = 0;
+			for (auto& location : index) size += location.size;
+			return size;
+		}
+
+		uint64 WorldArchive::get_decoded_size() const {
+			return static_cast<uint64>(header.width) * header.height * (sizeof(float) + 3);
+		}
+
+		double WorldArchive::decode_all() {
+			auto start = chrono::high_resolution_clock::now();
+			Decoded result;
+			for (unsigned chunk = 0; chunk < columns * rows; chunk++) {
+				for (unsigned layer = 0; layer < Layer_Count; layer++) decode(static_cast<Layer>(layer), chunk, result);
+			}
+			return chrono::duration<double>(chrono::high_resolution_clock::now() - start).count();
+		}
+
+	}
+
+}
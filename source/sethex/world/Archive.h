@@ -0,0 +1,121 @@
+#pragma once
+
+#include <fstream>
+#include <list>
+#include <unordered_map>
+
+#include <sethex/Common.h>
+#include <sethex/Images.h>
+#include <sethex/world/Generation.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Compressed file of the layers of a world, which are divided into square chunks that are decoded independently.
+		// The elevation is quantized to 16 bit and the climate layers are delta coded along the rows before each chunk is compressed by a byte oriented LZ codec.
+		// An index of the chunks allows to decode only those which are sampled, e.g. by the tiles around the camera, the decoded chunks are kept up to a capacity.
+		class WorldArchive {
+
+		public:
+
+			enum Layer { Elevation, Temperature, Precipitation, Biome_Ids, Layer_Count };
+
+			static const uint32 Version = 1;
+
+			static const unsigned Default_Chunk_Size = 128;
+			// the decoded elevations of a chunk of this size take 64 MB
+			static const unsigned Maximum_Chunk_Size = 4096;
+
+			struct Header {
+				char signature[4];
+				uint32 version;
+				uint32 width;
+				uint32 height;
+				uint32 chunk_size;
+				uint32 layer_count;
+				uint64 parameters_offset;
+				uint64 parameters_size;
+				uint64 index_offset;
+			};
+
+			// location of a compressed chunk of a layer
+			struct Index {
+				uint64 offset;
+				uint64 size;
+			};
+
+		private:
+
+			// decoded values of a chunk of a layer, elevations are converted back to floats
+			struct Decoded {
+				Lot<float> elevations;
+				Lot<uint8> values;
+				std::list<unsigned>::iterator usage;
+			};
+
+			Header header;
+			WorldParameters parameters;
+			unsigned columns = 0;
+			unsigned rows = 0;
+			Lot<Index> index;
+			std::ifstream stream;
+			Lot<uint8> compressed;
+
+			// keys of the decoded chunks (chunk * layers + layer) ordered from most to least recently used
+			std::list<unsigned> usage;
+			std::unordered_map<unsigned, Decoded> decoded;
+			unsigned capacity = 256;
+			unsigned decoded_count = 0;
+
+			const Decoded& decode(Layer layer, unsigned chunk);
+			void decode(Layer layer, unsigned chunk, Decoded& result);
+			// clamps "pixel" to the map, makes it relative to its chunk and returns the chunk
+			unsigned locate(signed2& pixel) const;
+
+		public:
+
+			// writes the maps of a world, whose biome colors are stored as their compact ids, throws a runtime exception if the file can't be written
+			static void write(const ci::fs::path& path, const WorldParameters& parameters, const Channel32f& elevation_map, const Channel& temperature_map,
+				const Channel& precipitation_map, const Surface& biome_map, unsigned chunk_size = Default_Chunk_Size);
+
+			// reads the index of the chunks, throws a runtime exception if the file isn't an archive of this version or its index exceeds the file
+			explicit WorldArchive(const ci::fs::path& path);
+
+			WorldArchive(const WorldArchive&) = delete;
+			WorldArchive& operator=(const WorldArchive&) = delete;
+
+			unsigned2 get_size() const {
+				return { header.width, header.height };
+			}
+
+			const WorldParameters& get_parameters() const {
+				return parameters;
+			}
+
+			// samples a layer at "pixel", which is clamped to the map, and decodes its chunk if necessary
+			float get_elevation(signed2 pixel);
+			uint8 get_temperature(signed2 pixel);
+			uint8 get_precipitation(signed2 pixel);
+			uint8 get_biome_id(signed2 pixel);
+
+			// number of decoded chunks, which are evicted once the capacity is exceeded
+			void set_capacity(unsigned chunks);
+
+			// number of chunks which have been decoded since the archive has been opened
+			unsigned get_decoded_count() const {
+				return decoded_count;
+			}
+
+			// bytes of the compressed chunks and of the maps they decode to (elevations as float)
+			uint64 get_compressed_size() const;
+			uint64 get_decoded_size() const;
+
+			// decodes every chunk of every layer without keeping them and returns the seconds this took, e.g. to measure the decoding speed
+			double decode_all();
+
+		};
+
+	}
+
+}
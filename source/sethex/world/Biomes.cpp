@@ -0,0 +1,206 @@
+#include "Biomes.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SETHEX_BIOMES_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace cinder;
+using namespace tenjix::float_constants;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		uint8 BiomeColors::get_id(Color8u biome_color) const {
+			if (biome_color == ice) return 2;
+			if (biome_color == tundra) return 3;
+			if (biome_color == taiga) return 4;
+			if (biome_color == steppe) return 5;
+			if (biome_color == prairie) return 6;
+			if (biome_color == forest) return 7;
+			if (biome_color == desert) return 8;
+			if (biome_color == savanna) return 9;
+			if (biome_color == rainforest) return 10;
+			if (biome_color == hot_rock) return 11;
+			if (biome_color == rock) return 12;
+			if (biome_color == cold_rock) return 13;
+			if (biome_color == beach) return 14;
+			if (biome_color == coast) return 15;
+			if (biome_color == ocean) return 16;
+			if (biome_color == deep_ocean) return 17;
+			return 1;
+		}
+
+		Color8u BiomeColors::get_color(uint8 biome_id) const {
+			const Color8u colors[] {
+				{}, {}, ice, tundra, taiga, steppe, prairie, forest, desert, savanna, rainforest, hot_rock, rock, cold_rock, beach, coast, ocean, deep_ocean
+			};
+			return biome_id < sizeof(colors) / sizeof(*colors) ? colors[biome_id] : colors[1];
+		}
+
+		const char* get_biome_name(uint8 biome_id) {
+			static const char* names[] { "", "Unknown", "Ice", "Tundra", "Taiga", "Steppe", "Prairie", "Forest", "Desert", "Savanna", "Rainforest", "Hot Rock", "Rock", "Cold Rock", "Beach", "Coast", "Ocean", "Deep Ocean" };
+			return biome_id < sizeof(names) / sizeof(*names) ? names[biome_id] : names[1];
+		}
+
+		Color8u BiomeDetermination::operator()(float elevation, float temperature, float precipitation) const {
+			auto& biome_colors = colors;
+			if (elevation_based) {
+				if (elevation > 0.33f * sealevel + thresholds.snowcap) return biome_colors.ice; // snowcap
+				if (elevation > 0.5f * sealevel + thresholds.mountain) return biome_colors.rock; // mountain
+				if (elevation > 0.66f * sealevel + thresholds.forrest) return biome_colors.forest; // forrest
+				if (elevation > sealevel + thresholds.prairie) return biome_colors.prairie; // prairie
+				if (elevation > sealevel + thresholds.beach) return biome_colors.beach; // beach
+				if (elevation > sealevel + thresholds.coast) return biome_colors.coast; // coast
+				if (elevation > sealevel + thresholds.ocean) return biome_colors.ocean; // ocean
+				return biome_colors.deep_ocean; // deep ocean
+			}
+			// water
+			if (elevation <= sealevel) {
+				// deep ocean
+				if (elevation < sealevel - 0.5f) return biome_colors.deep_ocean;
+				// ocean
+				if (elevation < sealevel - 0.25f) return biome_colors.ocean;
+				// coast
+				return biome_colors.coast;
+			}
+			// land
+			if (temperature < Zero) {
+				// below freezing point -> ice
+				return biome_colors.ice;
+			}
+			if (temperature < lower_threshold) {
+				// polar & dry -> rock
+				if (precipitation < lower_threshold) return biome_colors.rock;
+				// polar & nor -> tundra
+				if (precipitation < upper_threshold) return biome_colors.tundra;
+				// polar & wet -> taiga
+				return biome_colors.taiga;
+			}
+			if (temperature < upper_threshold) {
+				// temperate & dry -> steppe
+				if (precipitation < lower_threshold) return biome_colors.steppe;
+				// temperate & nor -> prairie
+				if (precipitation < upper_threshold) return biome_colors.prairie;
+				// temperate & wet -> forest
+				return biome_colors.forest;
+			}
+			// tropical & dry -> desert
+			if (precipitation < lower_threshold) return biome_colors.desert;
+			// tropical & nor -> savanna
+			if (precipitation < upper_threshold) return biome_colors.savanna;
+			// tropical & wet -> rainforest
+			return biome_colors.rainforest;
+		}
+
+		uint8 BiomeClassifier::biome(Color8u color) {
+			for (size_t index = 0; index < palette.size(); index++) {
+				if (palette[index] == color) return static_cast<uint8>(index);
+			}
+			palette.push_back(color);
+			return static_cast<uint8>(palette.size() - 1);
+		}
+
+		BiomeClassifier::BiomeClassifier(const BiomeDetermination& determination, const function<float(uint8)>& normalize_temperature) {
+			auto& biome_colors = determination.colors;
+			float sealevel = determination.sealevel;
+			auto& thresholds = determination.thresholds;
+			land_biomes.resize(256 * 256);
+			if (determination.elevation_based) {
+				float elevation_bounds[] { 0.33f * sealevel + thresholds.snowcap, 0.5f * sealevel + thresholds.mountain, 0.66f * sealevel + thresholds.forrest, sealevel + thresholds.prairie, sealevel + thresholds.beach, sealevel + thresholds.coast, sealevel + thresholds.ocean };
+				Color8u elevation_biomes[] { biome_colors.ice, biome_colors.rock, biome_colors.forest, biome_colors.prairie, biome_colors.beach, biome_colors.coast, biome_colors.ocean, biome_colors.deep_ocean };
+				band_count = 8;
+				first_water_band = 5;
+				for (unsigned band = 0; band < band_count; band++) {
+					if (band + 1 < band_count) bounds[band] = elevation_bounds[band];
+					band_biomes[band] = biome(elevation_biomes[band]);
+				}
+			} else {
+				// "elevation < bound" of the determination selects the band below, so the bound is lowered to the next smaller float
+				float lowest = -numeric_limits<float>::infinity();
+				bounds[0] = sealevel;
+				bounds[1] = nextafter(sealevel - 0.25f, lowest);
+				bounds[2] = nextafter(sealevel - 0.5f, lowest);
+				band_biomes[0] = Land;
+				band_biomes[1] = biome(biome_colors.coast);
+				band_biomes[2] = biome(biome_colors.ocean);
+				band_biomes[3] = biome(biome_colors.deep_ocean);
+				band_count = 4;
+				first_water_band = 1;
+				// the land doesn't depend on the elevation
+				float land = numeric_limits<float>::max();
+				for (unsigned temperature = 0; temperature < 256; temperature++) {
+					float normalized_temperature = normalize_temperature(static_cast<uint8>(temperature));
+					for (unsigned precipitation = 0; precipitation < 256; precipitation++) {
+						land_biomes[temperature * 256 + precipitation] = biome(determination(land, normalized_temperature, precipitation / 255.0f));
+					}
+				}
+			}
+		}
+
+		void BiomeClassifier::classify(const float* elevations, const uint8* temperatures, const uint8* precipitations, Color8u* biomes, size_t count, BiomeStatistics& statistics) const {
+			// colors a pixel of "band"
+			auto assign = [&](size_t index, unsigned band) {
+				uint8 biome = band_biomes[band];
+				if (biome == Land) biome = land_biomes[temperatures[index] * 256 + precipitations[index]];
+				statistics.water_pixels += band >= first_water_band;
+				biomes[index] = palette[biome];
+			};
+			size_t index = 0;
+		#ifdef SETHEX_BIOMES_SSE2
+			__m128 minima = _mm_set1_ps(statistics.elevation_minimum);
+			__m128 maxima = _mm_set1_ps(statistics.elevation_maximum);
+			for (; index + 4 <= count; index += 4) {
+				__m128 elevation = _mm_loadu_ps(elevations + index);
+				minima = _mm_min_ps(minima, elevation);
+				maxima = _mm_max_ps(maxima, elevation);
+				// the bands are selected in reverse order, so the first exceeded bound wins
+				__m128i band = _mm_set1_epi32(band_count - 1);
+				for (int bound = band_count - 2; bound >= 0; bound--) {
+					__m128i exceeded = _mm_castps_si128(_mm_cmpgt_ps(elevation, _mm_set1_ps(bounds[bound])));
+					band = _mm_or_si128(_mm_and_si128(exceeded, _mm_set1_epi32(bound)), _mm_andnot_si128(exceeded, band));
+				}
+				alignas(16) int32_t bands[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(bands), band);
+				for (size_t lane = 0; lane < 4; lane++) {
+					assign(index + lane, bands[lane]);
+				}
+			}
+			alignas(16) float lanes[4];
+			_mm_store_ps(lanes, minima);
+			for (float lane : lanes) statistics.elevation_minimum = minimum(statistics.elevation_minimum, lane);
+			_mm_store_ps(lanes, maxima);
+			for (float lane : lanes) statistics.elevation_maximum = maximum(statistics.elevation_maximum, lane);
+		#endif
+			for (; index < count; index++) {
+				float elevation = elevations[index];
+				statistics.elevation_minimum = minimum(statistics.elevation_minimum, elevation);
+				statistics.elevation_maximum = maximum(statistics.elevation_maximum, elevation);
+				unsigned band = band_count - 1;
+				for (int bound = band_count - 2; bound >= 0; bound--) {
+					if (elevation > bounds[bound]) band = bound;
+				}
+				assign(index, band);
+			}
+		}
+
+		void BiomeClassifier::measure(const float* elevations, size_t count, BiomeStatistics& statistics) const {
+			// a pixel is water unless it exceeds the bound of the last land band
+			float water_bound = bounds[first_water_band - 1];
+			for (size_t index = 0; index < count; index++) {
+				float elevation = elevations[index];
+				statistics.elevation_minimum = minimum(statistics.elevation_minimum, elevation);
+				statistics.elevation_maximum = maximum(statistics.elevation_maximum, elevation);
+				statistics.water_pixels += not (elevation > water_bound);
+			}
+		}
+
+	}
+
+}
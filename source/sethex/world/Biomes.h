@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <utilities/Mathematics.h>
+
+#include <sethex/Common.h>
+#include <sethex/Images.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		struct TerrainThresholds {
+			float ocean = -0.5f;
+			float coast = -0.1f;
+			float beach = 0.0f;
+			float prairie = 0.05f;
+			float forrest = 0.33f;
+			float mountain = 0.5f;
+			float snowcap = 0.66f;
+
+			bool operator==(const TerrainThresholds& other) {
+				return ocean == other.ocean
+					and coast == other.coast
+					and beach == other.beach
+					and prairie == other.prairie
+					and forrest == other.forrest
+					and mountain == other.mountain
+					and snowcap == other.snowcap;
+			}
+			bool operator!=(const TerrainThresholds& other) {
+				return not operator==(other);
+			}
+		};
+
+
+		// colors of the biomes in the biome map
+		struct BiomeColors {
+			ci::Color8u ice = { 255, 255, 255 };
+			ci::Color8u tundra = { 128, 128, 64 };
+			ci::Color8u taiga = { 0, 160, 80 };
+			ci::Color8u steppe = { 192, 192, 96 };
+			ci::Color8u prairie = { 0, 160, 0 };
+			ci::Color8u forest = { 0, 96, 0 };
+			ci::Color8u desert = { 255, 255, 128 };
+			ci::Color8u savanna = { 192, 240, 64 };
+			ci::Color8u rainforest = { 0, 64, 0 };
+			ci::Color8u hot_rock = { 160, 128, 128 };
+			ci::Color8u rock = { 128, 128, 128 };
+			ci::Color8u cold_rock = { 128, 128, 160 };
+			ci::Color8u beach = { 240, 240, 128 };
+			ci::Color8u coast = { 16, 16, 160 };
+			ci::Color8u ocean = { 0, 0, 128 };
+			ci::Color8u deep_ocean = { 0, 0, 92 };
+
+			// determines the compact id of a biome color (0 = none, 1 = unknown)
+			uint8 get_id(ci::Color8u biome_color) const;
+
+			// determines the color of a compact biome id (black for none and unknown)
+			ci::Color8u get_color(uint8 biome_id) const;
+		};
+
+		// name of a compact biome id
+		const char* get_biome_name(uint8 biome_id);
+
+
+		enum Biome_Determination { Elevation_Based, Climate_Based };
+
+		// settings of the biome determination, which are copied for a job so the interface can change them meanwhile
+		struct BiomeDetermination {
+			bool elevation_based;
+			float sealevel;
+			float lower_threshold;
+			float upper_threshold;
+			TerrainThresholds thresholds;
+			// copied as well, since the job thread reads them while the interface edits them
+			BiomeColors colors;
+
+			ci::Color8u operator()(float elevation, float temperature, float precipitation) const;
+		};
+
+
+		// statistics of classified pixels, which are gathered per row and merged afterwards
+		struct BiomeStatistics {
+			unsigned water_pixels = 0;
+			float elevation_minimum = 0.0f;
+			float elevation_maximum = 0.0f;
+
+			void merge(const BiomeStatistics& other) {
+				water_pixels += other.water_pixels;
+				elevation_minimum = minimum(elevation_minimum, other.elevation_minimum);
+				elevation_maximum = maximum(elevation_maximum, other.elevation_maximum);
+			}
+		};
+
+		// Classifies rows of pixels with the same results as a BiomeDetermination, but without branches per pixel.
+		// The thresholds become elevation bands, which are evaluated for four pixels at once with SSE2.
+		// Land of the climate based determination is looked up in a table of all 8 bit temperatures and precipitations.
+		// A classifier only reads its tables, so rows can be classified by multiple threads.
+		// The tables can be passed to a shader as well, which yields the same results for the same 8 bit maps.
+		class BiomeClassifier {
+
+		public:
+
+			// band of the climate based determination, which is looked up in the land table
+			enum : uint8 { Land = 255 };
+
+		private:
+
+			// a pixel belongs to the first band whose lower bound it exceeds, the last band has no bound
+			float bounds[7];
+			uint8 band_biomes[8];
+			unsigned band_count;
+			// bands from this one on are water
+			unsigned first_water_band;
+
+			Lot<ci::Color8u> palette;
+			Lot<uint8> land_biomes;
+
+			uint8 biome(ci::Color8u color);
+
+		public:
+
+			// "normalize_temperature" converts the temperatures of the temperature map for the determination
+			BiomeClassifier(const BiomeDetermination& determination, const std::function<float(uint8)>& normalize_temperature);
+
+			unsigned get_band_count() const {
+				return band_count;
+			}
+
+			// lower bounds of all bands except the last one
+			const float* get_bounds() const {
+				return bounds;
+			}
+
+			// palette indices of the bands or Land
+			const uint8* get_band_biomes() const {
+				return band_biomes;
+			}
+
+			// palette indices by temperature (rows) and precipitation (columns), which are zero for the elevation based determination
+			const Lot<uint8>& get_land_biomes() const {
+				return land_biomes;
+			}
+
+			const Lot<ci::Color8u>& get_palette() const {
+				return palette;
+			}
+
+			// classifies "count" pixels of a row, the precipitation is given like in the precipitation map [0, 255]
+			void classify(const float* elevations, const uint8* temperatures, const uint8* precipitations, ci::Color8u* biomes, std::size_t count, BiomeStatistics& statistics) const;
+
+			// gathers the statistics of "count" pixels of a row like classify, e.g. of biomes classified by the shader
+			void measure(const float* elevations, std::size_t count, BiomeStatistics& statistics) const;
+
+		};
+
+	}
+
+}
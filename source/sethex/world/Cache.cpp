@@ -0,0 +1,185 @@
+#include "Cache.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace cinder;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		namespace {
+
+			const char Spill_Signature[4] = { 'S', 'X', 'S', 'C' };
+			const uint32 Spill_Version = 1;
+
+			size_t row_size(const Channel32f& map) { return map.getWidth() * sizeof(float); }
+			size_t row_size(const Channel& map) { return map.getWidth(); }
+			size_t row_size(const Surface& map) { return map.getWidth() * 3; }
+
+			void create(shared<Channel32f>& map, int width, int height) { map = Channel32f::create(width, height); }
+			void create(shared<Channel>& map, int width, int height) { map = Channel::create(width, height); }
+			void create(shared<Surface>& map, int width, int height) { map = Surface::create(width, height, false, SurfaceChannelOrder::RGB); }
+
+			template<class Map>
+			size_t map_size(const shared<Map>& map) {
+				return map ? row_size(*map) * map->getHeight() : 0;
+			}
+
+			// writes the size and the rows of a map, which may be missing
+			template<class Map>
+			void write_map(ostream& stream, const shared<Map>& map) {
+				int32 size[2] = { map ? map->getWidth() : 0, map ? map->getHeight() : 0 };
+				stream.write(reinterpret_cast<const char*>(size), sizeof(size));
+				for (int row = 0; row < size[1]; row++) {
+					stream.write(reinterpret_cast<const char*>(map->getData(signed2(0, row))), row_size(*map));
+				}
+			}
+
+			template<class Map>
+			void read_map(istream& stream, shared<Map>& map) {
+				int32 size[2];
+				if (not stream.read(reinterpret_cast<char*>(size), sizeof(size)) or size[0] <= 0 or size[1] <= 0) return;
+				create(map, size[0], size[1]);
+				for (int row = 0; row < size[1]; row++) {
+					stream.read(reinterpret_cast<char*>(map->getData(signed2(0, row))), row_size(*map));
+				}
+			}
+
+		}
+
+		StageHash& StageHash::operator<<(const Simplex::Options& input) {
+			return *this << input.octaves << input.amplitude << input.frequency << input.lacunarity << input.persistence << input.power << input.positive;
+		}
+
+		StageHash& StageHash::operator<<(const TerrainThresholds& input) {
+			return *this << input.ocean << input.coast << input.beach << input.prairie << input.forrest << input.mountain << input.snowcap;
+		}
+
+		size_t StageOutputs::size() const {
+			return map_size(elevation_map) + map_size(temperature_map) + map_size(circulation_map) + map_size(evapotranspiration_map)
+				+ map_size(humidity_map) + map_size(precipitation_map) + map_size(biome_map);
+		}
+
+		shared<const StageOutputs> StageCache::find(uint64 key) {
+			auto found = index.find(key);
+			if (found != index.end()) {
+				entries.splice(entries.begin(), entries, found->second);
+				return found->second->outputs;
+			}
+			auto outputs = unspill(key);
+			if (outputs) insert(key, outputs);
+			return outputs;
+		}
+
+		bool StageCache::contains(uint64 key) const {
+			return index.count(key) or (not spill_directory.empty() and fs::exists(spill_path(key)));
+		}
+
+		void StageCache::insert(uint64 key, shared<const StageOutputs> outputs) {
+			if (index.count(key)) return;
+			size_t size = outputs->size();
+			entries.push_front({ key, move(outputs), size });
+			index[key] = entries.begin();
+			used += size;
+			evict();
+		}
+
+		void StageCache::evict() {
+			while (used > budget and not entries.empty()) {
+				auto& entry = entries.back();
+				spill(entry);
+				used -= entry.size;
+				index.erase(entry.key);
+				entries.pop_back();
+			}
+		}
+
+		void StageCache::clear() {
+			entries.clear();
+			index.clear();
+			used = 0;
+			if (spill_directory.empty() or not fs::exists(spill_directory)) return;
+			for (fs::directory_iterator file(spill_directory), end; file != end; ++file) {
+				if (file->path().extension() == ".stage") fs::remove(file->path());
+			}
+		}
+
+		void StageCache::set_spill_directory(const fs::path& directory) {
+			spill_directory = directory;
+			if (not spill_directory.empty()) fs::create_directories(spill_directory);
+		}
+
+		fs::path StageCache::spill_path(uint64 key) const {
+			ostringstream name;
+			name << hex << setw(16) << setfill('0') << key << ".stage";
+			return spill_directory / name.str();
+		}
+
+		void StageCache::spill(const Entry& entry) const {
+			if (spill_directory.empty()) return;
+			auto path = spill_path(entry.key);
+			// the outputs of a key never change, so a spilled entry remains valid
+			if (fs::exists(path)) return;
+			ofstream stream(path.string(), ios::binary);
+			auto& outputs = *entry.outputs;
+			stream.write(Spill_Signature, sizeof(Spill_Signature));
+			stream.write(reinterpret_cast<const char*>(&Spill_Version), sizeof(Spill_Version));
+			write_map(stream, outputs.elevation_map);
+			write_map(stream, outputs.temperature_map);
+			write_map(stream, outputs.circulation_map);
+			write_map(stream, outputs.evapotranspiration_map);
+			write_map(stream, outputs.humidity_map);
+			write_map(stream, outputs.precipitation_map);
+			write_map(stream, outputs.biome_map);
+			stream.write(reinterpret_cast<const char*>(&outputs.water_pixels), sizeof(outputs.water_pixels));
+			stream.write(reinterpret_cast<const char*>(&outputs.elevation_minimum), sizeof(outputs.elevation_minimum));
+			stream.write(reinterpret_cast<const char*>(&outputs.elevation_maximum), sizeof(outputs.elevation_maximum));
+			if (not stream) {
+				TENJIX_DEBUG("couldn't spill stage outputs to '", path, "'");
+				stream.close();
+				fs::remove(path);
+			}
+		}
+
+		shared<const StageOutputs> StageCache::unspill(uint64 key) const {
+			if (spill_directory.empty()) return nullptr;
+			auto path = spill_path(key);
+			ifstream stream(path.string(), ios::binary);
+			if (not stream) return nullptr;
+			char signature[sizeof(Spill_Signature)];
+			uint32 version = 0;
+			stream.read(signature, sizeof(signature));
+			stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+			auto outputs = make_shared<StageOutputs>();
+			// a file of another format is treated like a truncated one, instead of being read as empty outputs
+			bool valid = stream and equal(signature, signature + sizeof(signature), Spill_Signature) and version == Spill_Version;
+			if (valid) {
+				read_map(stream, outputs->elevation_map);
+				read_map(stream, outputs->temperature_map);
+				read_map(stream, outputs->circulation_map);
+				read_map(stream, outputs->evapotranspiration_map);
+				read_map(stream, outputs->humidity_map);
+				read_map(stream, outputs->precipitation_map);
+				read_map(stream, outputs->biome_map);
+				stream.read(reinterpret_cast<char*>(&outputs->water_pixels), sizeof(outputs->water_pixels));
+				stream.read(reinterpret_cast<char*>(&outputs->elevation_minimum), sizeof(outputs->elevation_minimum));
+				stream.read(reinterpret_cast<char*>(&outputs->elevation_maximum), sizeof(outputs->elevation_maximum));
+				valid = static_cast<bool>(stream);
+			}
+			if (not valid) {
+				// a truncated or outdated file is dropped, so the stage runs again
+				TENJIX_DEBUG("couldn't read stage outputs from '", path, "'");
+				stream.close();
+				fs::remove(path);
+				return nullptr;
+			}
+			return outputs;
+		}
+
+	}
+
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <list>
+#include <unordered_map>
+
+#include <cinder/utilities/Simplex.h>
+
+#include <sethex/Common.h>
+#include <sethex/Images.h>
+#include <sethex/world/Biomes.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// 64 bit FNV-1a hash of the inputs of a stage, which are appended member by member, since structures may contain padding
+		class StageHash {
+
+			uint64 value = 14695981039346656037ull;
+
+			void append(const void* data, size_t size) {
+				auto bytes = static_cast<const uint8*>(data);
+				for (size_t index = 0; index < size; index++) {
+					value = (value ^ bytes[index]) * 1099511628211ull;
+				}
+			}
+
+		public:
+
+			StageHash& operator<<(bool input) { return *this << static_cast<uint8>(input); }
+			StageHash& operator<<(uint8 input) { append(&input, sizeof(input)); return *this; }
+			StageHash& operator<<(int input) { append(&input, sizeof(input)); return *this; }
+			StageHash& operator<<(unsigned input) { append(&input, sizeof(input)); return *this; }
+			StageHash& operator<<(uint64 input) { append(&input, sizeof(input)); return *this; }
+			StageHash& operator<<(float input) { append(&input, sizeof(input)); return *this; }
+			StageHash& operator<<(float2 input) { return *this << input.x << input.y; }
+			StageHash& operator<<(unsigned2 input) { return *this << input.x << input.y; }
+			StageHash& operator<<(ci::Color8u input) { return *this << input.r << input.g << input.b; }
+			StageHash& operator<<(const String& input) { append(input.data(), input.size()); return *this << static_cast<unsigned>(input.size()); }
+			StageHash& operator<<(const Simplex::Options& input);
+			StageHash& operator<<(const TerrainThresholds& input);
+
+			uint64 get() const {
+				return value;
+			}
+
+		};
+
+		// maps produced by a stage, which are shared with the pipeline and never changed once they are cached
+		struct StageOutputs {
+			shared<Channel32f> elevation_map;
+			shared<Channel> temperature_map;
+			shared<Surface> circulation_map;
+			shared<Channel> evapotranspiration_map;
+			shared<Channel> humidity_map;
+			shared<Channel> precipitation_map;
+			shared<Surface> biome_map;
+			unsigned water_pixels = 0;
+			float elevation_minimum = 0.0f;
+			float elevation_maximum = 0.0f;
+
+			// bytes of the maps
+			size_t size() const;
+		};
+
+		// Content addressed cache of stage outputs, which are keyed by the hash of the inputs of the stage and the stages it depends on.
+		// The least recently used outputs are evicted once the memory budget is exceeded and written to the spill directory, if there is one.
+		// The cache is used by the render thread only.
+		class StageCache {
+
+			struct Entry {
+				uint64 key;
+				shared<const StageOutputs> outputs;
+				size_t size;
+			};
+
+			// most recently used entries first
+			std::list<Entry> entries;
+			std::unordered_map<uint64, std::list<Entry>::iterator> index;
+			size_t budget;
+			size_t used = 0;
+			ci::fs::path spill_directory;
+
+			ci::fs::path spill_path(uint64 key) const;
+			void spill(const Entry& entry) const;
+			shared<const StageOutputs> unspill(uint64 key) const;
+			void evict();
+
+		public:
+
+			explicit StageCache(size_t budget = 256 << 20) : budget(budget) {}
+
+			StageCache(const StageCache&) = delete;
+			StageCache& operator=(const StageCache&) = delete;
+
+			// outputs of "key" or nullptr, which become the most recently used ones and are read back from the spill directory if necessary
+			shared<const StageOutputs> find(uint64 key);
+
+			// whether "key" is in memory or in the spill directory
+			bool contains(uint64 key) const;
+
+			// adds outputs which aren't cached yet, the entry is spilled right away if it exceeds the budget alone
+			void insert(uint64 key, shared<const StageOutputs> outputs);
+
+			// removes all entries from the memory and the spill directory
+			void clear();
+
+			void set_budget(size_t bytes) {
+				budget = bytes;
+				evict();
+			}
+
+			size_t get_budget() const { return budget; }
+
+			// evicted entries are written to "directory" if it isn't empty
+			void set_spill_directory(const ci::fs::path& directory);
+
+			const ci::fs::path& get_spill_directory() const { return spill_directory; }
+
+			size_t get_used() const { return used; }
+
+			size_t get_count() const { return entries.size(); }
+
+		};
+
+	}
+
+}
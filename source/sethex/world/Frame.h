@@ -0,0 +1,270 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <map>
+
+#include <cinder/utilities/Assets.h>
+#include <cinder/utilities/Shaders.h>
+#include <cinder/utilities/Watchdog.h>
+
+#include <utilities/Exceptions.h>
+
+#include <sethex/Common.h>
+#include <sethex/Graphics.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Renders a map of the world generation by a fragment shader into a framebuffer, which is recompiled once the shader changes.
+		// Frames of several pipelines may watch the same shader, so their watching is shared.
+		class Frame {
+
+		public:
+
+			enum class Origin { LowerLeft, UpperLeft };
+
+		private:
+
+			ci::fs::path vertex_shader_path = "shaders/Square.vertex.shader";
+			ci::fs::path geometry_shader_path = "shaders/Square.geometry.shader";
+			ci::fs::path fragment_shader_path;
+
+			Origin origin = Origin::LowerLeft;
+			bool compiled_successfully = false;
+			unsigned current = 0;
+
+			shared<FrameBuffer> buffers[2];
+			shared<Shader> shader;
+			shared<Texture> result;
+
+			// copy of the result, which is written by the GPU in the background and mapped once it is needed
+			shared<PixelBuffer> pixel_buffer;
+			shared<Fence> fence;
+			signed2 read_size;
+
+			// flag of the pipeline, which is set once the recompiled shader should render again
+			bool* update = nullptr;
+
+			// frames by the path of their fragment shader, since the watchdog calls only one function per path
+			static std::map<String, Lot<Frame*>>& watching_frames() {
+				static std::map<String, Lot<Frame*>> frames;
+				return frames;
+			}
+
+			void unwatch() {
+				if (fragment_shader_path.empty()) return;
+				auto& frames = watching_frames()[fragment_shader_path.string()];
+				frames.erase(std::remove(frames.begin(), frames.end(), this), frames.end());
+				if (frames.empty()) {
+					watching_frames().erase(fragment_shader_path.string());
+					wd::unwatch(fragment_shader_path);
+				}
+			}
+
+			static void create(shared<Channel32f>& map, signed2 size) {
+				map = Channel32f::create(size.x, size.y);
+			}
+
+			static void create(shared<Channel>& map, signed2 size) {
+				map = Channel::create(size.x, size.y);
+			}
+
+			static void create(shared<Surface>& map, signed2 size) {
+				map = Surface::create(size.x, size.y, false, ci::SurfaceChannelOrder::RGB);
+			}
+
+		public:
+
+			Frame() = default;
+
+			~Frame() {
+				unwatch();
+			}
+
+			// the watchdog refers to the frame
+			Frame(const Frame&) = delete;
+			Frame& operator=(const Frame&) = delete;
+
+			ci::fs::path& get_fragment_shader_path() { return fragment_shader_path; }
+
+			Frame& framebuffer(unsigned2 size, GLint format = GL_RGBA32F, int samples = 0) {
+				buffers[0] = FrameBuffer::create(size.x, size.y, FrameBuffer::Format().samples(samples).disableDepth().colorTexture(Texture::Format().internalFormat(format)));
+				return *this;
+			}
+
+			Frame& dual_framebuffer(unsigned2 size, GLint format = GL_RGBA32F, int samples = 0) {
+				if (not buffers[0]) framebuffer(size, format);
+				buffers[1] = FrameBuffer::create(size.x, size.y, FrameBuffer::Format().samples(samples).disableDepth().colorTexture(Texture::Format().internalFormat(format)));
+				return *this;
+			}
+
+			bool initialized() { return buffers[0] != nullptr; }
+
+			unsigned active() { return current; }
+
+			unsigned inactive() { return 1 - current; }
+
+			Frame& activate(unsigned index) {
+				assert(index == 0 or index == 1);
+				current = index;
+			}
+
+			Frame& swap() { current = 1 - current; return *this; }
+
+			FrameBuffer& buffer() { return *buffers[current]; }
+
+			FrameBuffer& buffer(unsigned index) {
+				assert(index == 0 or index == 1);
+				return *buffers[index];
+			}
+
+			Frame& set(shared<Texture> texture) {
+				result = texture;
+				// a queued copy belongs to the replaced result
+				return discard();
+			}
+
+			// queues a copy of the result into a pixel buffer without waiting for the GPU
+			// the format and type have to match the map passed to "fetch" (e.g. GL_RED and GL_FLOAT for a Channel32f)
+			Frame& read(GLenum format, GLenum type) {
+				auto texture = this->texture();
+				unsigned components = format == GL_RGBA ? 4 : format == GL_RGB ? 3 : 1;
+				unsigned component_size = type == GL_FLOAT ? sizeof(float) : sizeof(uint8);
+				read_size = texture->getSize();
+				GLsizeiptr size = read_size.x * read_size.y * components * component_size;
+				if (not pixel_buffer or pixel_buffer->getSize() != size) pixel_buffer = PixelBuffer::create(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+				using namespace ci::gl;
+				ScopedBuffer scoped_buffer(pixel_buffer);
+				ScopedTextureBind scoped_texture(texture);
+				GLint alignment;
+				glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+				glPixelStorei(GL_PACK_ALIGNMENT, 1);
+				glGetTexImage(texture->getTarget(), 0, format, type, nullptr);
+				glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+				fence = Fence::create();
+				return *this;
+			}
+
+			// drops the copy queued by "read", e.g. if it has been superseded by a map of the CPU
+			Frame& discard() {
+				fence = nullptr;
+				return *this;
+			}
+
+			// whether the copy queued by "read" has arrived, so that "fetch" won't wait for it
+			bool fetchable() {
+				return not fence or fence->clientWaitSync(GL_SYNC_FLUSH_COMMANDS_BIT, 0) != GL_TIMEOUT_EXPIRED;
+			}
+
+			// replaces "map" by the copy queued by "read", which is waited for if necessary
+			// does nothing without a queued copy, so it can be called by every consumer of the map, returns whether "map" was replaced
+			template<class Map>
+			bool fetch(shared<Map>& map) {
+				if (not fence) return false;
+				while (fence->clientWaitSync(GL_SYNC_FLUSH_COMMANDS_BIT, 1000000) == GL_TIMEOUT_EXPIRED);
+				fence = nullptr;
+				create(map, read_size);
+				auto data = static_cast<const uint8*>(pixel_buffer->mapBufferRange(0, pixel_buffer->getSize(), GL_MAP_READ_BIT));
+				size_t row_size = pixel_buffer->getSize() / read_size.y;
+				for (int row = 0; row < read_size.y; row++) {
+					// OpenGL starts with the bottom row, which is flipped like by the image source of a texture
+					memcpy(map->getData(signed2(0, read_size.y - 1 - row)), data + row * row_size, row_size);
+				}
+				pixel_buffer->unmap();
+				return true;
+			}
+
+			shared<Texture> texture() {
+				runtime_assert(buffers[current], "buffers[", current, "] isn't initialized");
+				return result ? result : buffers[current]->getColorTexture();
+			}
+
+			shared<Texture> texture(unsigned index) {
+				assert(index == 0 or index == 1);
+				return buffers[index]->getColorTexture();
+			}
+
+			Frame& fragment(const String& fragment_shader_path, bool& update, Origin origin = Origin::LowerLeft) {
+				this->origin = origin;
+				this->update = &update;
+				if (fragment_shader_path == this->fragment_shader_path) return *this;
+				compiled_successfully = false;
+				unwatch();
+				this->fragment_shader_path = fragment_shader_path;
+				auto& frames = watching_frames()[this->fragment_shader_path.string()];
+				frames.push_back(this);
+				if (frames.size() == 1) {
+					wd::watch(fragment_shader_path, [path = this->fragment_shader_path.string()](const ci::fs::path&) {
+						for (auto frame : watching_frames()[path]) {
+							if (frame->compile()) *frame->update = true;
+						}
+					});
+				} else if (compile()) {
+					update = true;
+				}
+				return *this;
+			}
+
+			template<class Type>
+			void uniform(const String& name, Type value) {
+				if (not compiled_successfully) return;
+				shader->uniform(name, value);
+			}
+
+			template<class Type>
+			void uniform(const String& name, const Type* values, int count) {
+				if (not compiled_successfully) return;
+				shader->uniform(name, values, count);
+			}
+
+			bool compile() {
+				try {
+					TENJIX_DEBUG("compiling shader '", fragment_shader_path.filename(), "' ...");
+					String vertex_shader = ci::loadString(ci::app::loadAsset(vertex_shader_path));
+					String geometry_shader = ci::loadString(ci::app::loadAsset(geometry_shader_path));
+					if (origin == Origin::UpperLeft) shader::define(geometry_shader, "ORIGIN_UPPER_LEFT");
+					String fragment_shader = ci::loadString(ci::app::loadAsset(fragment_shader_path));
+					if (origin == Origin::UpperLeft)  shader::define(fragment_shader, "ORIGIN_UPPER_LEFT");
+					shader = Shader::create(vertex_shader, fragment_shader, geometry_shader);
+					compiled_successfully = true;
+				} catch (ci::gl::GlslProgExc exception) {
+					error(exception.what());
+					compiled_successfully = false;
+				}
+				return compiled_successfully;
+			}
+
+			bool compiled() {
+				return compiled_successfully;
+			}
+
+			void render(std::initializer_list<shared<Texture>> textures = {}) {
+				set(nullptr);
+				if (not compiled_successfully) return;
+				TENJIX_DEBUG("rendering ", fragment_shader_path.filename(), " ...");
+				auto buffer = buffers[current];
+				assert(buffer);
+				assert(shader);
+				using namespace ci::gl;
+				ScopedFramebuffer scoped_framebuffer(buffer);
+				ScopedViewport scoped_viewport(buffer->getSize());
+				ScopedGlslProg scoped_shader(shader);
+				uint8 unit = 0;
+				for (auto& texture : textures) {
+					assert(texture);
+					texture->bind(unit++);
+				}
+				drawArrays(GL_POINTS, 0, 1);
+				unit = 0;
+				for (auto& texture : textures) {
+					texture->unbind(unit++);
+				}
+			}
+
+		};
+
+	}
+
+}
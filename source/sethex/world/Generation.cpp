@@ -0,0 +1,621 @@
+#include "Generation.h"
+
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
+#include <sethex/Parallel.h>
+
+#include <utilities/Exceptions.h>
+
+using namespace cinder;
+using namespace tenjix::float_constants;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		const Lot<String> WorldParameters::preset_list { "Default", "Alpha World", "Beta World", "Continents", "Islands", "Earth" };
+
+		bool WorldParameters::apply_preset(unsigned preset, bool high_resolution) {
+			float resolution_factor = high_resolution ? 1.0f : 0.5f;
+			float resolution_adjustment = high_resolution ? 0.0f : 230.0f;
+			switch (preset) {
+				case 0:
+					seed = 0;
+					scale = 1.0f;
+					shift = {};
+					options = {};
+					use_continents = false;
+					continent_frequency = 0.5f;
+					continent_amplitude = 1.0f;
+					sealevel = 0.0f;
+					thresholds = TerrainThresholds();
+					equator_distance_factor = 0.0f;
+					equator_distance_power = 10;
+					wrap_horizontally = false;
+					biome_determination = Climate_Based;
+					break;
+				case 1:
+					seed = 0;
+					scale = 2.0f * resolution_factor;
+					shift = { -300 * resolution_factor, -5420 + resolution_adjustment };
+					options = {};
+					options.octaves = 5;
+					use_continents = true;
+					continent_frequency = 0.25f;
+					continent_amplitude = 2.0f;
+					sealevel = 0.25f;
+					thresholds.ocean = -0.20f;
+					thresholds.coast = -0.02f;
+					thresholds.beach = 0.0f;
+					thresholds.prairie = 0.02f;
+					thresholds.forrest = 0.25f;
+					thresholds.mountain = 0.40f;
+					thresholds.snowcap = 0.55f;
+					equator_distance_factor = 0.0f;
+					circulation_intensity = 1.0f;
+					precipitation_intensity = 1.0f;
+					lapse_rate = 9.0f;
+					transpiration_factor = 0.5f;
+					humidity_saturation = 50.0f;
+					wrap_horizontally = true;
+					break;
+				case 2:
+					seed = 0;
+					scale = 1.32f * resolution_factor;
+					shift = { -320 * resolution_factor, -4880 + resolution_adjustment };
+					options = {};
+					options.octaves = 5;
+					use_continents = true;
+					continent_frequency = 0.25f;
+					continent_amplitude = 2.0f;
+					sealevel = 0.25f;
+					thresholds.ocean = -0.20f;
+					thresholds.coast = -0.02f;
+					thresholds.beach = 0.0f;
+					thresholds.prairie = 0.02f;
+					thresholds.forrest = 0.25f;
+					thresholds.mountain = 0.40f;
+					thresholds.snowcap = 0.55f;
+					equator_distance_factor = -0.15f;
+					equator_distance_power = 15;
+					circulation_intensity = 1.0f;
+					precipitation_intensity = 1.0f;
+					lapse_rate = 9.0f;
+					transpiration_factor = 0.5f;
+					humidity_saturation = 50.0f;
+					wrap_horizontally = true;
+					break;
+				case 3:
+					seed = 0;
+					scale = 1.15f * resolution_factor;
+					shift = { 360 * resolution_factor, -8160 + resolution_adjustment };
+					options = {};
+					options.octaves = 5;
+					use_continents = true;
+					continent_amplitude = 2.0f;
+					continent_frequency = 0.25f;
+					sealevel = 0.25f;
+					thresholds.ocean = -0.20f;
+					thresholds.coast = -0.02f;
+					thresholds.beach = 0.0f;
+					thresholds.prairie = 0.02f;
+					thresholds.forrest = 0.25f;
+					thresholds.mountain = 0.40f;
+					thresholds.snowcap = 0.55f;
+					equator_distance_factor = -0.4f;
+					equator_distance_power = 15;
+					circulation_intensity = 1.0f;
+					precipitation_intensity = 1.0f;
+					lapse_rate = 9.0f;
+					transpiration_factor = 0.5f;
+					humidity_saturation = 50.0f;
+					wrap_horizontally = true;
+					break;
+				case 4:
+					seed = 0;
+					scale = 2.0f * resolution_factor;
+					shift = { 360 * resolution_factor, 2720 + resolution_adjustment };
+					options = {};
+					options.octaves = 5;
+					use_continents = true;
+					continent_amplitude = 1.0f;
+					continent_frequency = 0.5f;
+					sealevel = 0.25f;
+					thresholds.ocean = -0.20f;
+					thresholds.coast = -0.02f;
+					thresholds.beach = 0.0f;
+					thresholds.prairie = 0.02f;
+					thresholds.forrest = 0.25f;
+					thresholds.mountain = 0.40f;
+					thresholds.snowcap = 0.55f;
+					equator_distance_factor = -0.4f;
+					equator_distance_power = 15;
+					circulation_intensity = 1.0f;
+					precipitation_intensity = 1.0f;
+					lapse_rate = 9.0f;
+					transpiration_factor = 0.5f;
+					humidity_saturation = 50.0f;
+					wrap_horizontally = true;
+					break;
+				case 5:
+					maximum_elevation = 8850;
+					circulation_iterations = 50;
+					circulation_intensity = 0.5f;
+					precipitation_intensity = 1.1f;
+					lapse_rate = 6.5f;
+					sealevel = 0.0f;
+					evaporation_factor = 1.0f;
+					transpiration_factor = 0.25f;
+					thresholds.ocean = -0.50f;
+					thresholds.coast = -0.10f;
+					thresholds.beach = 0.0f;
+					thresholds.prairie = 0.0f;
+					thresholds.forrest = 0.05f;
+					thresholds.mountain = 0.20f;
+					thresholds.snowcap = 0.25f;
+					break;
+				default: return false;
+			}
+			return true;
+		}
+
+		void WorldParameters::read(istream& stream) {
+			// readers of the values by name, which fail the stream for invalid values
+			unordered_map<String, function<void(istream&)>> readers;
+			auto add = [&](const char* name, auto& value) {
+				readers[name] = [&value](istream& stream) { stream >> value; };
+			};
+			add("seed", seed);
+			add("scale", scale);
+			readers["shift"] = [this](istream& stream) { stream >> shift.x >> shift.y; };
+			add("octaves", options.octaves);
+			add("amplitude", options.amplitude);
+			add("frequency", options.frequency);
+			add("lacunarity", options.lacunarity);
+			add("persistence", options.persistence);
+			add("power", options.power);
+			add("wrap_horizontally", wrap_horizontally);
+			add("use_continents", use_continents);
+			add("continent_frequency", continent_frequency);
+			add("continent_amplitude", continent_amplitude);
+			add("equator_distance_factor", equator_distance_factor);
+			add("equator_distance_power", equator_distance_power);
+			add("sealevel", sealevel);
+			add("equator", equator);
+			add("maximum_elevation", maximum_elevation);
+			add("maximum_temperature", maximum_temperature);
+			add("minimum_temperature", minimum_temperature);
+			add("lapse_rate", lapse_rate);
+			add("evaporation_factor", evaporation_factor);
+			add("transpiration_factor", transpiration_factor);
+			add("precipitation_factor", precipitation_factor);
+			add("precipitation_decay", precipitation_decay);
+			add("humidity_saturation", humidity_saturation);
+			add("upper_precipitation", upper_precipitation);
+			add("circulation_iterations", circulation_iterations);
+			add("circulation_intensity", circulation_intensity);
+			add("precipitation_intensity", precipitation_intensity);
+			add("orograpic_effect", orograpic_effect);
+			add("maximum_precipitation", maximum_precipitation);
+			add("biome_determination", biome_determination);
+			add("lower_threshold", lower_threshold);
+			add("upper_threshold", upper_threshold);
+			add("ocean", thresholds.ocean);
+			add("coast", thresholds.coast);
+			add("beach", thresholds.beach);
+			add("prairie", thresholds.prairie);
+			add("forrest", thresholds.forrest);
+			add("mountain", thresholds.mountain);
+			add("snowcap", thresholds.snowcap);
+			// colors are read as three integers, since a uint8 would be read as character
+			auto add_color = [&](const char* name, Color8u& color) {
+				readers[name] = [&color](istream& stream) {
+					int r, g, b;
+					if (not (stream >> r >> g >> b)) return;
+					if (r < 0 or r > 255 or g < 0 or g > 255 or b < 0 or b > 255) stream.setstate(ios::failbit);
+					else color = Color8u(static_cast<uint8>(r), static_cast<uint8>(g), static_cast<uint8>(b));
+				};
+			};
+			add_color("color_ice", biome_colors.ice);
+			add_color("color_tundra", biome_colors.tundra);
+			add_color("color_taiga", biome_colors.taiga);
+			add_color("color_steppe", biome_colors.steppe);
+			add_color("color_prairie", biome_colors.prairie);
+			add_color("color_forest", biome_colors.forest);
+			add_color("color_desert", biome_colors.desert);
+			add_color("color_savanna", biome_colors.savanna);
+			add_color("color_rainforest", biome_colors.rainforest);
+			add_color("color_hot_rock", biome_colors.hot_rock);
+			add_color("color_rock", biome_colors.rock);
+			add_color("color_cold_rock", biome_colors.cold_rock);
+			add_color("color_beach", biome_colors.beach);
+			add_color("color_coast", biome_colors.coast);
+			add_color("color_ocean", biome_colors.ocean);
+			add_color("color_deep_ocean", biome_colors.deep_ocean);
+			String line;
+			while (getline(stream, line)) {
+				istringstream line_stream(line);
+				String name, equals;
+				if (not (line_stream >> name) or name[0] == '#') continue;
+				if (not (line_stream >> equals) or equals != "=") throw_runtime_exception("expected '=' after '", name, "'");
+				auto reader = readers.find(name);
+				if (reader == readers.end()) throw_runtime_exception("unknown parameter '", name, "'");
+				line_stream >> boolalpha;
+				reader->second(line_stream);
+				if (line_stream.fail()) throw_runtime_exception("invalid value of parameter '", name, "'");
+			}
+		}
+
+		void WorldParameters::write(ostream& stream) const {
+			// floats are written with enough digits to be read back exactly
+			stream << setprecision(numeric_limits<float>::max_digits10) << boolalpha;
+			auto add = [&](const char* name, const auto& value) {
+				stream << name << " = " << value << '\n';
+			};
+			add("seed", seed);
+			add("scale", scale);
+			stream << "shift = " << shift.x << ' ' << shift.y << '\n';
+			add("octaves", options.octaves);
+			add("amplitude", options.amplitude);
+			add("frequency", options.frequency);
+			add("lacunarity", options.lacunarity);
+			add("persistence", options.persistence);
+			add("power", options.power);
+			add("wrap_horizontally", wrap_horizontally);
+			add("use_continents", use_continents);
+			add("continent_frequency", continent_frequency);
+			add("continent_amplitude", continent_amplitude);
+			add("equator_distance_factor", equator_distance_factor);
+			add("equator_distance_power", equator_distance_power);
+			add("sealevel", sealevel);
+			add("equator", equator);
+			add("maximum_elevation", maximum_elevation);
+			add("maximum_temperature", maximum_temperature);
+			add("minimum_temperature", minimum_temperature);
+			add("lapse_rate", lapse_rate);
+			add("evaporation_factor", evaporation_factor);
+			add("transpiration_factor", transpiration_factor);
+			add("precipitation_factor", precipitation_factor);
+			add("precipitation_decay", precipitation_decay);
+			add("humidity_saturation", humidity_saturation);
+			add("upper_precipitation", upper_precipitation);
+			add("circulation_iterations", circulation_iterations);
+			add("circulation_intensity", circulation_intensity);
+			add("precipitation_intensity", precipitation_intensity);
+			add("orograpic_effect", orograpic_effect);
+			add("maximum_precipitation", maximum_precipitation);
+			add("biome_determination", biome_determination);
+			add("lower_threshold", lower_threshold);
+			add("upper_threshold", upper_threshold);
+			add("ocean", thresholds.ocean);
+			add("coast", thresholds.coast);
+			add("beach", thresholds.beach);
+			add("prairie", thresholds.prairie);
+			add("forrest", thresholds.forrest);
+			add("mountain", thresholds.mountain);
+			add("snowcap", thresholds.snowcap);
+			auto add_color = [&](const char* name, Color8u color) {
+				stream << name << " = " << int(color.r) << ' ' << int(color.g) << ' ' << int(color.b) << '\n';
+			};
+			add_color("color_ice", biome_colors.ice);
+			add_color("color_tundra", biome_colors.tundra);
+			add_color("color_taiga", biome_colors.taiga);
+			add_color("color_steppe", biome_colors.steppe);
+			add_color("color_prairie", biome_colors.prairie);
+			add_color("color_forest", biome_colors.forest);
+			add_color("color_desert", biome_colors.desert);
+			add_color("color_savanna", biome_colors.savanna);
+			add_color("color_rainforest", biome_colors.rainforest);
+			add_color("color_hot_rock", biome_colors.hot_rock);
+			add_color("color_rock", biome_colors.rock);
+			add_color("color_cold_rock", biome_colors.cold_rock);
+			add_color("color_beach", biome_colors.beach);
+			add_color("color_coast", biome_colors.coast);
+			add_color("color_ocean", biome_colors.ocean);
+			add_color("color_deep_ocean", biome_colors.deep_ocean);
+		}
+
+		BiomeDetermination WorldParameters::get_biome_determination() const {
+			return { biome_determination == Elevation_Based, sealevel, lower_threshold, upper_threshold, thresholds, biome_colors };
+		}
+
+		// calculates the elevations of positions given as separate coordinates, which are three-dimensional if "z" isn't empty
+		// the coordinates are scaled in place
+		void calculate_elevations(const Simplex::Batch& simplex, Lot<float>& x, Lot<float>& y, Lot<float>& z, Lot<float>& elevations, const Simplex::Options& options, bool continents, float continent_frequency, float continent_amplitude) {
+			size_t count = x.size();
+			bool cylindrical = not z.empty();
+			auto scale = [&](float factor) {
+				for (size_t index = 0; index < count; index++) {
+					x[index] *= factor;
+					y[index] *= factor;
+					if (cylindrical) z[index] *= factor;
+				}
+			};
+			elevations.resize(count);
+			scale(0.01f);
+			if (cylindrical) simplex.noise(x.data(), y.data(), z.data(), elevations.data(), count, options);
+			else simplex.noise(x.data(), y.data(), elevations.data(), count, options);
+			if (continents) {
+				Lot<float> continental_elevations(count);
+				scale(continent_frequency);
+				if (cylindrical) simplex.noise(x.data(), y.data(), z.data(), continental_elevations.data(), count);
+				else simplex.noise(x.data(), y.data(), continental_elevations.data(), count);
+				for (size_t index = 0; index < count; index++) {
+					elevations[index] = (elevations[index] + continent_amplitude * continental_elevations[index]) / (options.amplitude + continent_amplitude);
+				}
+			}
+		}
+
+		void generate_elevation(const WorldParameters& parameters, const Simplex::Batch& simplex, const ElevationSection& section, Job& job, GenerationMaps& maps) {
+			signed2 size = section.size;
+			signed2 drag = section.drag;
+			unsigned2 full_resolution = section.full_resolution;
+			// positions are measured in pixels of the full resolution, so previews show the same section
+			float2 center = float2(full_resolution) / 2.0f;
+			float pixel_size = section.pixel_size;
+			auto& elevation_buffer = maps.elevation_buffer;
+			auto previous_buffer = elevation_buffer;
+			elevation_buffer = Channel32f::create(size.x, size.y);
+			// generates every "step"th pixel within the columns [first, last) of a row into the buffer, each sample is repeated up to the next one
+			auto generate = [&](int row, int first, int last, int step) {
+				float* values = elevation_buffer->getData(signed2(0, row));
+				Lot<float> x, y, z, elevations;
+				for (int column = first; column < last; column += step) {
+					float2 position = float2(column, row) * pixel_size;
+					if (parameters.wrap_horizontally) {
+						float repeat_interval = full_resolution.x / parameters.scale;
+						position.y = (position.y - center.y) / parameters.scale + center.y;
+						position += parameters.shift;
+						float radians = position.x / full_resolution.x * Tau;
+						x.push_back(sin(radians) / Tau * repeat_interval);
+						y.push_back(position.y);
+						z.push_back(cos(radians) / Tau * repeat_interval);
+					} else {
+						position = (position - center) / parameters.scale + center;
+						position += parameters.shift;
+						x.push_back(position.x);
+						y.push_back(position.y);
+					}
+				}
+				calculate_elevations(simplex, x, y, z, elevations, parameters.options, parameters.use_continents, parameters.continent_frequency, parameters.continent_amplitude);
+				for (size_t index = 0; index < elevations.size(); index++) {
+					int column = first + static_cast<int>(index) * step;
+					std::fill(values + column, values + minimum(column + step, last), elevations[index]);
+				}
+			};
+			atomic<int> generated_rows { 0 };
+			auto report = [&](int rows) {
+				job.progress(static_cast<float>(generated_rows += rows) / size.y);
+			};
+			// each pixel only depends on its position, so parallel bands of rows yield the same result as a single thread
+			if (section.retained) {
+				// copies the pixels which remain visible by the dragged distance
+				int moved_columns = size.x - abs(drag.x);
+				for (int row = maximum(drag.y, 0); row < size.y + minimum(drag.y, 0); row++) {
+					float* destination = elevation_buffer->getData(signed2(0, row));
+					float* source = previous_buffer->getData(signed2(0, row - drag.y));
+					if (parameters.wrap_horizontally) {
+						// the cylindrical projection repeats horizontally, so columns only rotate
+						std::rotate_copy(source, source + (size.x - drag.x) % size.x, source + size.x, destination);
+					} else {
+						std::copy(source + maximum(-drag.x, 0), source + maximum(-drag.x, 0) + moved_columns, destination + maximum(drag.x, 0));
+					}
+				}
+				// only the exposed bands are generated
+				int first_exposed_row = drag.y > 0 ? 0 : size.y + drag.y;
+				int last_exposed_row = drag.y > 0 ? drag.y : size.y;
+				int first_exposed_column = drag.x > 0 ? 0 : size.x + drag.x;
+				int last_exposed_column = drag.x > 0 ? drag.x : size.x;
+				bool columns_exposed = drag.x != 0 and not parameters.wrap_horizontally;
+				ThreadPool::instance().parallel_for(0, size.y, 8, [&](int row) {
+					if (job.cancelled()) return;
+					if (row >= first_exposed_row and row < last_exposed_row) generate(row, 0, size.x, 1);
+					else if (columns_exposed) generate(row, first_exposed_column, last_exposed_column, 1);
+					report(1);
+				});
+			} else {
+				int step = section.preview ? Elevation_Preview_Step : 1;
+				ThreadPool::instance().parallel_for(0, (size.y + step - 1) / step, maximum(8 / step, 1), [&](int band) {
+					if (job.cancelled()) return;
+					int row = band * step;
+					generate(row, 0, size.x, step);
+					float* values = elevation_buffer->getData(signed2(0, row));
+					for (int copy = row + 1; copy < minimum(row + step, size.y); copy++) {
+						std::copy(values, values + size.x, elevation_buffer->getData(signed2(0, copy)));
+					}
+					report(minimum(step, size.y - row));
+				});
+		}
+			if (job.cancelled()) return;
+			maps.elevation_map = Channel32f::create(*elevation_buffer);
+			maps.elevation_generated = true;
+		}
+
+		void generate_topography(const WorldParameters& parameters, const Simplex::Generator& simplex, unsigned2 resolution, unsigned resolution_divisor, Job& job, GenerationMaps& maps) {
+			float temperature_range = parameters.temperature_range();
+			auto& elevation_map = maps.elevation_map;
+			auto& temperature_map = maps.temperature_map;
+			elevation_map = Channel32f::create(resolution.x, resolution.y);
+			temperature_map = Channel::create(resolution.x, resolution.y);
+			auto buffer_iterator = maps.elevation_buffer->getIter();
+			auto elevation_iterator = elevation_map->getIter();
+			auto temperature_iterator = temperature_map->getIter();
+			while (buffer_iterator.line() and elevation_iterator.line() and temperature_iterator.line()) {
+				float y = static_cast<float>(elevation_iterator.y()) / resolution.y; // y position [0.0, 1.0] 
+				float distance_to_equator = abs(2.0f * (y - 0.5f)); // distance to equator [0.0, 1.0] 
+				float elevation_change = pow(distance_to_equator, parameters.equator_distance_power) * parameters.equator_distance_factor;
+				while (buffer_iterator.pixel() and elevation_iterator.pixel() and temperature_iterator.pixel()) {
+					float elevation = buffer_iterator.v();
+					elevation = clamp(elevation + elevation_change, -1.0f, 1.0f);
+					elevation_iterator.v() = elevation;
+					float2 position = float2(elevation_iterator.getPos()) * static_cast<float>(resolution_divisor);
+					float temperature = 1.0f - distance_to_equator * distance_to_equator;
+					//float temperature_noise = Simplex::to_unsigned(Simplex::noise(position.x * 0.02f * parameters.continent_frequency)); 
+					float temperature_noise = Simplex::to_unsigned(simplex.noise(position * 0.02f * parameters.continent_frequency));
+					temperature = mix(temperature, temperature_noise, 0.1f);
+					if (elevation > parameters.sealevel) {
+						float elevation_above_sealevel_in_km = (elevation - parameters.sealevel) * parameters.maximum_elevation * 0.001f;
+						temperature -= parameters.lapse_rate * elevation_above_sealevel_in_km / temperature_range;
+					} else {
+						temperature -= 0.1f;
+					}
+					temperature = clamp(temperature, 0.0f, 1.0f);
+					temperature_iterator.v() = static_cast<uint8>(temperature * 255.0f + 0.5f);
+				}
+				if (not job.progress(static_cast<float>(elevation_iterator.y() + 1) / resolution.y)) return;
+		}
+		}
+
+		void generate_linear_climate(const WorldParameters& parameters, unsigned2 resolution, Job& job, GenerationMaps& maps) {
+			auto& elevation_map = maps.elevation_map;
+			auto& temperature_map = maps.temperature_map;
+			auto& precipitation_map = maps.precipitation_map;
+			if (not precipitation_map or precipitation_map->getSize() != signed2(resolution)) precipitation_map = Channel::create(resolution.x, resolution.y);
+			else precipitation_map = Channel::create(*precipitation_map);
+			// the humidity of each belt is carried along one trajectory per slot, which are stored contiguously per belt
+			unsigned width = resolution.x;
+			Lot<float> humidity_map(6 * width);
+			unsigned map_height_sixth = resolution.y / 6;
+			// the maps are accessed by raw pointers with the row strides in elements
+			const float* elevations = elevation_map->getData();
+			const uint8* temperatures = temperature_map->getData();
+			uint8* precipitations = precipitation_map->getData();
+			ptrdiff_t elevation_stride = elevation_map->getRowBytes() / sizeof(float);
+			ptrdiff_t temperature_stride = temperature_map->getRowBytes();
+			ptrdiff_t precipitation_stride = precipitation_map->getRowBytes();
+
+			auto calculate_evapotranspiration_precipitation = [&](unsigned belt, unsigned slot, unsigned& x, unsigned y, int x_delta, float& previous_elevation) {
+				float elevation = elevations[y * elevation_stride + x];
+				float elevation_above_sealevel = max(elevation - parameters.sealevel, 0.0f) / (1.0f - parameters.sealevel);
+				float temperature = temperatures[y * temperature_stride + x] / 255.0f;
+				float evapotranspiration = 0.0f;
+				float precipitation = 0.0f;
+				float& humidity_of_slot = humidity_map[belt * width + slot];
+				float humidity = humidity_of_slot;
+				float slope = 0.0f;
+				bool land = elevation > parameters.sealevel;
+				evapotranspiration = temperature * (land ? parameters.transpiration_factor : parameters.evaporation_factor);
+				evapotranspiration = min(evapotranspiration, parameters.humidity_saturation * temperature - humidity);
+				humidity += evapotranspiration;
+				if (land) {
+					if (y > 0) {
+						if (isnan(previous_elevation)) {
+							previous_elevation = elevations[(y - 1) * elevation_stride + static_cast<int>(x) - x_delta];
+						}
+						slope = (elevation - previous_elevation) * 100.0f * parameters.orograpic_effect;
+					}
+					//precipitation = clamp(slope * elevation_above_sealevel * elevation_above_sealevel + 0.1f, 0.0f, 1.0f) * parameters.precipitation_factor;
+					precipitation = clamp(slope * elevation_above_sealevel * elevation_above_sealevel + humidity / (parameters.humidity_saturation * temperature), 0.0f, 1.0f) * parameters.precipitation_factor;
+					precipitation = min(precipitation, humidity);
+					humidity -= precipitation;
+				}
+				precipitations[y * precipitation_stride + x] = static_cast<uint8>(precipitation * 255.0f + 0.5f);
+				humidity_of_slot = humidity;
+				previous_elevation = elevation;
+				x = project(x + x_delta, 0, resolution.x - 1);
+			};
+
+			//srand(15);
+			auto calculate_precipitation = [&](unsigned belt, unsigned slot, unsigned& x, unsigned y, int x_delta) {
+				float elevation = elevations[y * elevation_stride + x];
+				bool land = elevation > parameters.sealevel;
+				float& humidity_of_slot = humidity_map[belt * width + slot];
+				float humidity = humidity_of_slot;
+				float precipitation = humidity * parameters.precipitation_decay;
+				//precipitation = min(precipitation, humidity);
+				precipitation = min(precipitation * precipitation, 1.0f);
+				humidity -= precipitation;
+				if (land) {
+					uint8& mapped_precipitation = precipitations[y * precipitation_stride + x];
+					float existing_precipitation = mapped_precipitation / 255.0f;
+					mapped_precipitation = static_cast<uint8>(min(existing_precipitation + precipitation, 1.0f) * 255.0f + 0.5f);
+				}
+				humidity_of_slot = humidity;
+				//bool drift = (rand() % 100) < 10;
+				x = project(x + x_delta, 0, resolution.x - 1);
+			};
+
+			// the rows of a belt are passed in the direction of the wind, which shifts the trajectory horizontally each row
+			struct Belt {
+				unsigned first_row;
+				int row_delta;
+				int x_delta;
+			};
+			unsigned sixth = map_height_sixth;
+			const Belt low_altitude_belts[6] = { { 0, +1, -1 }, { 2 * sixth - 1, -1, +1 }, { 2 * sixth, +1, -1 }, { 4 * sixth - 1, -1, -1 }, { 4 * sixth, +1, +1 }, { 6 * sixth - 1, -1, -1 } };
+			const Belt high_altitude_belts[6] = { { sixth - 1, -1, +1 }, { sixth, +1, -1 }, { 3 * sixth - 1, -1, +1 }, { 3 * sixth, +1, +1 }, { 5 * sixth - 1, -1, -1 }, { 5 * sixth, +1, +1 } };
+
+			// the trajectories are independent, since the horizontal shift maps the slots of a row onto distinct pixels and the belts cover distinct rows
+			int trajectories = static_cast<int>(6 * width);
+			atomic<int> passed_trajectories { 0 };
+
+			// low altitude wind
+			ThreadPool::instance().parallel_for(0, trajectories, 16, [&](int trajectory) {
+				if (job.cancelled()) return;
+				unsigned belt = trajectory / width, slot = trajectory % width;
+				const Belt& wind = low_altitude_belts[belt];
+				float previous_elevation = NAN;
+				unsigned x = slot;
+				unsigned y = wind.first_row;
+				for (unsigned row = 0; row < map_height_sixth; row++, y += wind.row_delta) {
+					calculate_evapotranspiration_precipitation(belt, slot, x, y, wind.x_delta, previous_elevation);
+				}
+				job.progress(0.5f * ++passed_trajectories / trajectories);
+			});
+			if (job.cancelled()) return;
+			if (parameters.upper_precipitation) {
+				// humidity exchange of rising air
+				for (unsigned slot = 0; slot < width; slot++) {
+					for (unsigned belt = 0; belt < 6; belt += 2) {
+						float& lower = humidity_map[belt * width + slot];
+						float& upper = humidity_map[(belt + 1) * width + slot];
+						lower = upper = (lower + upper) / 2.0f;
+					}
+				}
+				// high altitude wind
+				passed_trajectories = 0;
+				ThreadPool::instance().parallel_for(0, trajectories, 16, [&](int trajectory) {
+					if (job.cancelled()) return;
+					unsigned belt = trajectory / width, slot = trajectory % width;
+					const Belt& wind = high_altitude_belts[belt];
+					unsigned x = slot;
+					unsigned y = wind.first_row;
+					for (unsigned row = 0; row < map_height_sixth; row++, y += wind.row_delta) {
+						calculate_precipitation(belt, slot, x, y, wind.x_delta);
+					}
+					job.progress(0.5f + 0.5f * ++passed_trajectories / trajectories);
+				});
+		}
+		}
+
+		void classify_biomes(const BiomeClassifier& classifier, unsigned2 resolution, Job& job, GenerationMaps& maps) {
+			auto& biome_map = maps.biome_map;
+			biome_map = Surface::create(resolution.x, resolution.y, false, SurfaceChannelOrder::RGB);
+			int rows = resolution.y;
+			Lot<BiomeStatistics> row_statistics(rows);
+			atomic<int> classified_rows { 0 };
+			ThreadPool::instance().parallel_for(0, rows, 8, [&](int row) {
+				if (job.cancelled()) return;
+				signed2 start(0, row);
+				// the pixels of a surface without alpha are stored like an array of colors
+				auto biomes = reinterpret_cast<Color8u*>(biome_map->getData(start));
+				classifier.classify(maps.elevation_map->getData(start), maps.temperature_map->getData(start), maps.precipitation_map->getData(start), biomes, resolution.x, row_statistics[row]);
+				job.progress(static_cast<float>(++classified_rows) / rows);
+			});
+			if (job.cancelled()) return;
+			BiomeStatistics statistics;
+			for (auto& statistics_of_row : row_statistics) {
+				statistics.merge(statistics_of_row);
+		}
+			maps.water_pixels = statistics.water_pixels;
+			maps.elevation_minimum = statistics.elevation_minimum;
+			maps.elevation_maximum = statistics.elevation_maximum;
+		}
+	}
+
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <iosfwd>
+
+#include <cinder/utilities/Simplex.h>
+#include <cinder/utilities/SimplexBatch.h>
+
+#include <utilities/Mathematics.h>
+
+#include <sethex/Common.h>
+#include <sethex/Images.h>
+#include <sethex/Jobs.h>
+#include <sethex/world/Biomes.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// parameters of the world generation, which are copied for each job so the interface can change them meanwhile
+		struct WorldParameters {
+
+			// tectonic
+			int seed = 0;
+			float scale = 1.0f;
+			float2 shift;
+			Simplex::Options options;
+			bool wrap_horizontally = false;
+			bool use_continents = false;
+			float continent_frequency = 0.5f;
+			float continent_amplitude = 1.0f;
+			float equator_distance_factor = 0.0f;
+			int equator_distance_power = 10;
+
+			// topography
+			float sealevel = 0.0f;
+			float equator = 0.0f;
+			float maximum_elevation = 10000.0f;
+			float maximum_temperature = +45.0f;
+			float minimum_temperature = -25.0f;
+			float lapse_rate = 9.0f;
+
+			// climate
+			float evaporation_factor = 1.0f;
+			float transpiration_factor = 0.25f;
+			float precipitation_factor = 1.0f;
+			float precipitation_decay = 0.05f;
+			float humidity_saturation = 50.0f;
+			bool upper_precipitation = true;
+			unsigned circulation_iterations = 50;
+			float circulation_intensity = 1.0f;
+			float precipitation_intensity = 1.0f;
+			float orograpic_effect = 1.0f;
+			float maximum_precipitation = 80.0f;
+
+			// biomes
+			int biome_determination = Climate_Based;
+			float lower_threshold = float_constants::One_Third;
+			float upper_threshold = float_constants::Two_Thirds;
+			TerrainThresholds thresholds;
+			BiomeColors biome_colors;
+
+			// names of the presets of the interface
+			static const Lot<String> preset_list;
+
+			// changes the parameters of a preset, which are tuned for the full resolution of the interface (1600 x 900 or 800 x 450)
+			// parameters which aren't part of the preset are kept, returns false for an unknown preset
+			bool apply_preset(unsigned preset, bool high_resolution);
+
+			// reads lines of "name = value" (e.g. "seed = 42" or "shift = -300 -5420"), empty lines and lines starting with '#' are skipped
+			// throws a runtime exception for unknown names and invalid values
+			void read(std::istream& stream);
+
+			// writes all parameters as lines of "name = value", which are read back unchanged
+			void write(std::ostream& stream) const;
+
+			// settings of the biome determination, which a classifier or a stage copies
+			BiomeDetermination get_biome_determination() const;
+
+			float temperature_range() const {
+				return maximum_temperature - minimum_temperature;
+			}
+
+			float convert_to_celcius(uint8 temperature) const {
+				return temperature / 255.0f * temperature_range() + minimum_temperature;
+			}
+
+			float normalize_temperature(uint8 temperature) const {
+				float temperature_in_degrees = convert_to_celcius(temperature);
+				float temperature_range_from_zero = temperature_range() + sign(temperature_in_degrees) * minimum_temperature;
+				return temperature_in_degrees / temperature_range_from_zero;
+			}
+
+		};
+
+		// maps of a generation job, which start out as the displayed maps and replace them once the job has finished
+		// stages create new maps instead of changing the displayed ones, since those are read by the render thread meanwhile
+		struct GenerationMaps {
+			shared<Channel32f> elevation_buffer;
+			shared<Channel32f> elevation_map;
+			shared<Channel> temperature_map;
+			shared<Channel> precipitation_map;
+			shared<Surface> biome_map;
+			bool elevation_generated = false;
+			unsigned water_pixels = 0;
+			float elevation_minimum = 0.0f;
+			float elevation_maximum = 0.0f;
+		};
+
+		// section of the elevation, which is generated with "size" pixels of "pixel_size" pixels of the full resolution
+		// a dragged section retains the pixels of the previous elevation buffer, which remain visible
+		struct ElevationSection {
+			signed2 size;
+			unsigned2 full_resolution;
+			float pixel_size = 1.0f;
+			bool preview = false;
+			bool retained = false;
+			signed2 drag;
+		};
+
+		// distance between the samples of the elevation preview, which is shown while zooming
+		const int Elevation_Preview_Step = 4;
+
+		// The CPU stages of the world generation, which report their progress to the job and return early if it's cancelled.
+		// They don't depend on a window or a graphics context, so they can be run by a headless generator as well.
+
+		// generates the elevation buffer with simplex noise and copies it into the elevation map
+		void generate_elevation(const WorldParameters& parameters, const Simplex::Batch& simplex, const ElevationSection& section, Job& job, GenerationMaps& maps);
+
+		// adjusts the elevation by the distance to the equator and calculates the temperature
+		void generate_topography(const WorldParameters& parameters, const Simplex::Generator& simplex, unsigned2 resolution, unsigned resolution_divisor, Job& job, GenerationMaps& maps);
+
+		// calculates the precipitation with the linear circulation of six wind belts
+		void generate_linear_climate(const WorldParameters& parameters, unsigned2 resolution, Job& job, GenerationMaps& maps);
+
+		// classifies the biomes and gathers the water pixels and the elevation range
+		void classify_biomes(const BiomeClassifier& classifier, unsigned2 resolution, Job& job, GenerationMaps& maps);
+
+	}
+
+}
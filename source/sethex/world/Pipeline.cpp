@@ -0,0 +1,551 @@
+#include "Pipeline.h"
+
+#include <cinder/utilities/Assets.h>
+#include <cinder/utilities/SimplexBatch.h>
+
+#include <utilities/Exceptions.h>
+#include <utilities/Mathematics.h>
+
+using namespace cinder;
+using namespace tenjix::float_constants;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// resolution divisor of the first pass of the progressive generation, which is halved by every refinement
+		const unsigned Progressive_Divisor = 4;
+
+		void WorldGenerationPipeline::ElevationMap::load(const String& file_path) {
+			if (file_path.empty() or file_path == path and loaded()) return;
+			TENJIX_DEBUG("loading elevation map '", file_path, "' ...");
+			path = file_path;
+			try {
+				texture = Texture::create(loadImage(app::loadAsset(path)));
+			} catch (exception exception) {
+				texture = nullptr;
+				TENJIX_DEBUG("couldn't load '", file_path, "'");
+			}
+		}
+
+		WorldGenerationPipeline::WorldGenerationPipeline(bool high_resolution)
+			: full_resolution(high_resolution ? unsigned2(1600, 900) : unsigned2(800, 450)) {
+		}
+
+		void WorldGenerationPipeline::navigate(signed2 drag, float roll) {
+			this->drag += drag;
+			this->roll += roll;
+			dirty_stages[Tectonic] |= this->drag != Zero or this->roll != Zero;
+		}
+
+		bool WorldGenerationPipeline::all_compiled() {
+			switch (elevation_source) {
+				case CPU_Noise:
+					return temperature_frame.compiled() and evapotranspiration_frame.compiled() and circulation_frame.compiled() and humidity_frame.compiled();
+				case GPU_Noise:
+				case Elevation_Map:
+				case Elevation_Maps:
+					return elevation_frame.compiled() and temperature_frame.compiled() and evapotranspiration_frame.compiled() and circulation_frame.compiled() and humidity_frame.compiled();
+				default:
+					throw_runtime_exception();
+			}
+		}
+
+		void WorldGenerationPipeline::load_resources() {
+			unsigned2 map_resolution = full_resolution / resolution_divisor;
+			if (framebuffer_resolution != map_resolution) {
+				framebuffer_resolution = map_resolution;
+				elevation_frame.framebuffer(map_resolution, GL_R32F);
+				temperature_frame.framebuffer(map_resolution, GL_R32F).fragment("shaders/generation/Temperature.fragment.shader", dirty_stages[Topography]);
+				evapotranspiration_frame.framebuffer(map_resolution, GL_R32F).fragment("shaders/generation/Evapotranspiration.fragment.shader", dirty_stages[Climate]);
+				circulation_frame.framebuffer(map_resolution, GL_RGB32F).fragment("shaders/generation/Circulation.fragment.shader", dirty_stages[Climate]);
+				humidity_frame.framebuffer(map_resolution, GL_R32F).dual_framebuffer(map_resolution, GL_R32F).fragment("shaders/generation/Humidity.fragment.shader", dirty_stages[Climate]);
+				precipitation_frame.framebuffer(map_resolution, GL_R32F, 16).fragment("shaders/generation/Precipitation.fragment.shader", dirty_stages[Climate]);
+				biome_frame.framebuffer(map_resolution, GL_RGB8).fragment("shaders/generation/Biome.fragment.shader", dirty_stages[Biomes]);
+			}
+
+			switch (elevation_source) {
+				case CPU_Noise:
+					available = true;
+					break;
+				case GPU_Noise:
+					elevation_frame.fragment("shaders/generation/Elevation.fragment.shader", dirty_stages[Tectonic], Frame::Origin::UpperLeft);
+					available = all_compiled();
+					break;
+				case Elevation_Map:
+					elevation_frame.fragment("shaders/generation/Elevation-Sampling.fragment.shader", dirty_stages[Tectonic], Frame::Origin::LowerLeft);
+					height_map.load(height_file);
+					available = height_map.loaded() and all_compiled();
+					break;
+				case Elevation_Maps:
+					elevation_frame.fragment("shaders/generation/Elevation-Composing.fragment.shader", dirty_stages[Tectonic], Frame::Origin::LowerLeft);
+					bathymetry_map.load(bathymetry_file);
+					topography_map.load(topography_file);
+					available = bathymetry_map.loaded() and topography_map.loaded() and all_compiled();
+					break;
+				default:
+					throw_runtime_exception();
+			}
+		}
+
+		bool WorldGenerationPipeline::update() {
+			// dragging and zooming wait for the running job instead, since they are continued by the next one
+			bool changed = settings_changed();
+			bool navigating = drag != Zero or roll != 0.0f;
+			if (job and changed and not navigating) {
+				job.reset();
+				job_maps = nullptr;
+				dirty_stages[job_restart] = true;
+				// the elevation buffer lags behind the shift of an interrupted drag
+				if (job_restart == Tectonic) elevation_buffer = nullptr;
+			}
+
+			// changed settings restart the progressive generation from the coarsest resolution, while dragging and zooming keep the current resolution
+			if (not progressive) {
+				resolution_divisor = 1;
+				refine_resolution = false;
+			} else if (changed and not navigating) {
+				// settings which have been generated before are restored at the full resolution right away
+				resolution_divisor = cache.contains(stage_key(Biomes, 1)) ? 1 : Progressive_Divisor;
+				refine_resolution = false;
+				dirty_stages[Tectonic] = true;
+			} else if (refine_resolution) {
+				resolution_divisor /= 2;
+				refine_resolution = false;
+				dirty_stages[Tectonic] = true;
+			}
+
+			load_resources();
+			finish_job();
+
+			// the preview of a zoom is refined once it is displayed
+			if (refine_elevation and not job) dirty_stages[Tectonic] = true;
+
+			if (available and not job and settings_changed()) schedule_stages();
+			start_job();
+			return complete_display();
+		}
+
+		void WorldGenerationPipeline::finish_job() {
+			if (not job or not job->finished()) return;
+			stage_timings.clear();
+			for (unsigned stage = 0; stage < job->stage_count(); stage++) {
+				stage_timings.emplace_back(job->stage_name(stage), job->stage_seconds(stage));
+			}
+			failure.clear();
+			if (job->failed()) {
+				// the maps of the failed job are incomplete, so the previous ones remain displayed
+				try {
+					job->rethrow();
+				} catch (const exception& exception) {
+					failure = exception.what();
+				} catch (...) {
+					failure = "unknown exception";
+				}
+				TENJIX_DEBUG("generation failed: ", failure);
+				job.reset();
+				job_maps = nullptr;
+				return;
+			}
+			job.reset();
+			elevation_buffer = job_maps->elevation_buffer;
+			elevation_map = job_maps->elevation_map;
+			temperature_map = job_maps->temperature_map;
+			precipitation_map = job_maps->precipitation_map;
+			biome_map = job_maps->biome_map;
+			water_pixels = job_maps->water_pixels;
+			elevation_minimum = job_maps->elevation_minimum;
+			elevation_maximum = job_maps->elevation_maximum;
+			// textures can only be created on the render thread
+			if (job_maps->elevation_generated) elevation_frame.set(Texture::create(*elevation_map));
+			job_maps = nullptr;
+			if (job_continuation != Stage_Count) dirty_stages[job_continuation] = true;
+		}
+
+		void WorldGenerationPipeline::schedule_stages() {
+			print("===== update =====");
+			unsigned2 map_resolution = full_resolution / resolution_divisor;
+			job_continuation = Stage_Count;
+
+			// appends the CPU part of a stage to the job, which starts with the first of them
+			auto add_stage = [&](Stage stage, const char* name, function<void(Job&, GenerationMaps&)> work) {
+				if (not job) {
+					job.reset(new Job());
+					job_maps = make_shared<GenerationMaps>();
+					job_restart = stage;
+				}
+				job->stage(name, [maps = job_maps, work](Job& job) {
+					work(job, *maps);
+				});
+			};
+
+			// a stage with a GPU part needs the results of the job, so it continues once the job has finished
+			auto await_job = [&](Stage stage) {
+				if (not dirty_stages[stage] or not job) return;
+				job_continuation = stage;
+				// the following stages are updated after the awaited one anyway
+				dirty_stages[Topography] = dirty_stages[Climate] = dirty_stages[Biomes] = false;
+			};
+
+			if (dirty_stages[Tectonic]) {
+				print("update tectonic");
+				parameters.scale = clamp(parameters.scale * (1.0f - roll), 0.1f, 10.0f);
+				parameters.shift -= parameters.wrap_horizontally ? float2(drag.x, drag.y / parameters.scale) : float2(drag) / parameters.scale;
+				if (parameters.seed < 0 || parameters.seed > Seed_Maximum) parameters.seed = Seed_Maximum;
+				if (restore(Tectonic)) {
+					refine_elevation = false;
+				} else if (elevation_source == Elevation_Map or elevation_source == Elevation_Maps) {
+					if (elevation_source == Elevation_Map) {
+						elevation_frame.uniform("uElevationMap", 0);
+						elevation_frame.uniform("uElevationScale", height_scale);
+						elevation_frame.render({ height_map.texture });
+					} else {
+						elevation_frame.uniform("uBathymetryMap", 0);
+						elevation_frame.uniform("uTopographyMap", 1);
+						elevation_frame.uniform("uBathymetryScale", bathymetry_scale);
+						elevation_frame.uniform("uTopographyScale", topography_scale);
+						elevation_frame.render({ bathymetry_map.texture, topography_map.texture });
+					}
+					elevation_frame.read(GL_RED, GL_FLOAT);
+					elevation_buffer = nullptr;
+				} else if (elevation_source == GPU_Noise) {
+					elevation_buffer = nullptr;
+					elevation_frame.uniform("uWrapping", parameters.wrap_horizontally);
+					elevation_frame.uniform("uResolution", full_resolution);
+					elevation_frame.uniform("uPixelSize", static_cast<float>(resolution_divisor));
+					//elevation_frame.shader->uniform("uSeed", parameters.seed);
+					elevation_frame.uniform("uShift", parameters.shift);
+					elevation_frame.uniform("uScale", parameters.scale);
+					elevation_frame.uniform("uOctaces", parameters.options.octaves);
+					elevation_frame.uniform("uAmplitude", parameters.options.amplitude);
+					elevation_frame.uniform("uFrequency", parameters.options.frequency);
+					elevation_frame.uniform("uLacunarity", parameters.options.lacunarity);
+					elevation_frame.uniform("uPersistence", parameters.options.persistence);
+					elevation_frame.uniform("uPower", parameters.options.power);
+					elevation_frame.uniform("uContinentalAmplitudeFactor", parameters.continent_amplitude);
+					elevation_frame.uniform("uContinentalFrequencyFactor", parameters.continent_frequency);
+					//elevation_frame.uniform("uContinentalShift", parameters.seed);
+					elevation_frame.uniform("uEquatorDistanceFactor", parameters.equator_distance_factor);
+					elevation_frame.uniform("uEquatorDistancePower", parameters.equator_distance_power);
+					elevation_frame.render();
+					elevation_frame.read(GL_RED, GL_FLOAT);
+				} else {
+					simplex.seed(parameters.seed);
+					ElevationSection section;
+					section.size = signed2(map_resolution);
+					section.full_resolution = full_resolution;
+					section.pixel_size = static_cast<float>(resolution_divisor);
+					// zooming shows a coarse preview first, which is refined once the zoom has settled
+					section.preview = roll != 0.0f;
+					section.retained = not section.preview and not refine_elevation and resolution_divisor == 1 and drag != Zero and elevation_buffer and elevation_buffer->getSize() == section.size and elevation_buffer->getIncrement() == 1 and abs(drag.x) < section.size.x and abs(drag.y) < section.size.y;
+					section.drag = drag;
+					refine_elevation = section.preview;
+					add_stage(Tectonic, "Tectonic", [parameters = parameters, section, simplex = Simplex::Batch(simplex)](Job& job, GenerationMaps& maps) {
+						generate_elevation(parameters, simplex, section, job, maps);
+					});
+				}
+				drag = Zero;
+				roll = 0.0f;
+				complete(Tectonic);
+			}
+
+			if (dirty_stages[Topography] and (elevation_source == GPU_Noise or circulation_type == Deflected)) await_job(Topography);
+			if (dirty_stages[Topography]) {
+				print("update topography");
+				if (restore(Topography)) {
+					// the cached temperatures replace those of the GPU
+				} else {
+					if (elevation_source == GPU_Noise or circulation_type == Deflected) {
+						temperature_frame.uniform("uElevationMap", 0);
+						temperature_frame.uniform("uSeaLevel", parameters.sealevel);
+						temperature_frame.uniform("uEquator", parameters.equator);
+						temperature_frame.uniform("uLapseRate", parameters.lapse_rate / parameters.temperature_range());
+						temperature_frame.uniform("uElevationScale", parameters.maximum_elevation * 0.001f);
+						temperature_frame.render({ elevation_frame.texture() });
+						// the CPU part replaces the temperatures of the GPU, which are only needed as texture then
+						if (elevation_source != CPU_Noise) temperature_frame.read(GL_RED, GL_UNSIGNED_BYTE);
+					}
+					if (elevation_source == CPU_Noise) {
+						add_stage(Topography, "Topography", [parameters = parameters, simplex = simplex, map_resolution, resolution_divisor = resolution_divisor](Job& job, GenerationMaps& maps) {
+							generate_topography(parameters, simplex, map_resolution, resolution_divisor, job, maps);
+						});
+					}
+				}
+				complete(Topography);
+			}
+
+			if (dirty_stages[Climate] and circulation_type == Deflected) await_job(Climate);
+			if (dirty_stages[Climate]) {
+				print("update climate");
+				if (restore(Climate)) {
+					// the precipitation is restored as texture for the classification of the GPU
+				} else if (circulation_type == Deflected) {
+					// calculate circulation
+					circulation_frame.uniform("uTemperatureMap", 0);
+					circulation_frame.uniform("uEquator", parameters.equator);
+					circulation_frame.uniform("uDebug", debug_circulation);
+					circulation_frame.render({ temperature_frame.texture() });
+					circulation_frame.read(GL_RGB, GL_UNSIGNED_BYTE);
+					// calculate evapotranspiration
+					evapotranspiration_frame.uniform("uElevationMap", 0);
+					evapotranspiration_frame.uniform("uTemperatureMap", 1);
+					evapotranspiration_frame.uniform("uSeaLevel", parameters.sealevel);
+					evapotranspiration_frame.uniform("uEquator", parameters.equator);
+					evapotranspiration_frame.uniform("uEvaporation", parameters.evaporation_factor);
+					evapotranspiration_frame.uniform("uTranspiration", parameters.transpiration_factor);
+					evapotranspiration_frame.render({ elevation_frame.texture(), temperature_frame.texture() });
+					evapotranspiration_frame.read(GL_RED, GL_UNSIGNED_BYTE);
+					// calculate humidity by simulating calculation
+					humidity_frame.uniform("uElevationMap", 0);
+					humidity_frame.uniform("uCirculationMap", 1);
+					humidity_frame.uniform("uHumidityMap", 2);
+					humidity_frame.uniform("uSeaLevel", parameters.sealevel);
+					humidity_frame.uniform("uIntensity", parameters.circulation_intensity);
+					humidity_frame.uniform("uOrograpicEffect", parameters.orograpic_effect);
+					shared<Texture> humidity_texture = evapotranspiration_frame.texture();
+					for (unsigned iteration = 1; iteration <= parameters.circulation_iterations; iteration++) {
+						humidity_frame.uniform("uIteration", iteration);
+						humidity_frame.swap().render({ elevation_frame.texture(), circulation_frame.texture(), humidity_texture });
+						humidity_texture = humidity_frame.texture();
+					}
+					humidity_frame.read(GL_RED, GL_UNSIGNED_BYTE);
+					// calculate precipitation
+					precipitation_frame.uniform("uElevationMap", 0);
+					precipitation_frame.uniform("uTemperatureMap", 1);
+					precipitation_frame.uniform("uCirculationMap", 2);
+					precipitation_frame.uniform("uHumidityMap", 3);
+					precipitation_frame.uniform("uSeaLevel", parameters.sealevel);
+					precipitation_frame.uniform("uEquator", parameters.equator);
+					precipitation_frame.uniform("uIntensity", parameters.precipitation_intensity);
+					precipitation_frame.uniform("uCirculation", parameters.circulation_intensity);
+					precipitation_frame.uniform("uOrograpicEffect", parameters.orograpic_effect);
+					precipitation_frame.render({ elevation_frame.texture(), temperature_frame.texture(), circulation_frame.texture(), humidity_texture });
+					precipitation_frame.read(GL_RED, GL_UNSIGNED_BYTE);
+				} else {
+					add_stage(Climate, "Climate", [parameters = parameters, map_resolution](Job& job, GenerationMaps& maps) {
+						generate_linear_climate(parameters, map_resolution, job, maps);
+					});
+				}
+				complete(Climate);
+			}
+
+			// the biomes are classified on the GPU if the maps they depend on are results of the GPU, so these aren't read back
+			bool classify_on_gpu = gpu_biomes and biome_frame.compiled() and elevation_source != CPU_Noise and (parameters.biome_determination == Elevation_Based or circulation_type == Deflected);
+			if (dirty_stages[Biomes] and classify_on_gpu) await_job(Biomes);
+			if (dirty_stages[Biomes]) {
+				print("update biomes");
+				if (restore(Biomes)) {
+					// the cached biomes are displayed instead of a copy of the GPU
+				} else {
+					auto classifier = make_shared<const BiomeClassifier>(parameters.get_biome_determination(), [parameters = parameters](uint8 temperature) { return parameters.normalize_temperature(temperature); });
+					if (classify_on_gpu) {
+						int band_count = classifier->get_band_count();
+						Lot<int> band_biomes(classifier->get_band_biomes(), classifier->get_band_biomes() + band_count);
+						Lot<float3> palette;
+						for (auto& color : classifier->get_palette()) {
+							palette.push_back(float3(color.r, color.g, color.b) / 255.0f);
+						}
+						auto land_biomes_format = Texture::Format().internalFormat(GL_R8UI).dataType(GL_UNSIGNED_BYTE).minFilter(GL_NEAREST).magFilter(GL_NEAREST);
+						auto land_biomes = Texture::create(classifier->get_land_biomes().data(), GL_RED_INTEGER, 256, 256, land_biomes_format);
+						biome_frame.uniform("uElevationMap", 0);
+						biome_frame.uniform("uTemperatureMap", 1);
+						biome_frame.uniform("uPrecipitationMap", 2);
+						biome_frame.uniform("uLandBiomes", 3);
+						biome_frame.uniform("uBounds", classifier->get_bounds(), band_count - 1);
+						biome_frame.uniform("uBandBiomes", band_biomes.data(), band_count);
+						biome_frame.uniform("uBandCount", band_count);
+						biome_frame.uniform("uPalette", palette.data(), static_cast<int>(palette.size()));
+						biome_frame.render({ elevation_frame.texture(), temperature_frame.texture(), precipitation_frame.texture(), land_biomes });
+						biome_frame.read(GL_RGB, GL_UNSIGNED_BYTE);
+						gpu_classifier = classifier;
+					} else {
+						// a queued copy of the GPU belongs to previous settings
+						biome_frame.discard();
+						biome_differences = -1;
+						add_stage(Biomes, "Biomes", [classifier, map_resolution](Job& job, GenerationMaps& maps) {
+							classify_biomes(*classifier, map_resolution, job, maps);
+						});
+					}
+				}
+				complete(Biomes);
+			}
+
+			// without a stage awaiting the job, its results are displayed
+			if (job and job_continuation == Stage_Count) {
+				dirty_stages[Display] = false;
+				job_continuation = Display;
+			}
+		}
+
+		void WorldGenerationPipeline::start_job() {
+			// a job starts once the copies of the GPU results it reads have arrived, so the render thread doesn't wait for the GPU
+			if (not job or job->started() or not elevation_frame.fetchable() or not temperature_frame.fetchable() or not precipitation_frame.fetchable()) return;
+			elevation_frame.fetch(elevation_map);
+			temperature_frame.fetch(temperature_map);
+			precipitation_frame.fetch(precipitation_map);
+			job_maps->elevation_buffer = elevation_buffer;
+			job_maps->elevation_map = elevation_map;
+			job_maps->temperature_map = temperature_map;
+			job_maps->precipitation_map = precipitation_map;
+			job_maps->biome_map = biome_map;
+			job_maps->water_pixels = water_pixels;
+			job_maps->elevation_minimum = elevation_minimum;
+			job_maps->elevation_maximum = elevation_maximum;
+			job->start();
+		}
+
+		bool WorldGenerationPipeline::complete_display() {
+			// biomes of the GPU are displayed once their copy has arrived, which replaces the statistics of the CPU stage
+			if (not dirty_stages[Display] or not biome_frame.fetchable()) return false;
+			if (biome_frame.fetch(biome_map)) {
+				elevation_frame.fetch(elevation_map);
+				// the statistics are gathered from the elevation bands of the classifier, since the colors of two biomes may be equal
+				BiomeStatistics statistics;
+				for (int row = 0; row < elevation_map->getHeight(); row++) {
+					gpu_classifier->measure(elevation_map->getData(signed2(0, row)), elevation_map->getWidth(), statistics);
+				}
+				water_pixels = statistics.water_pixels;
+				elevation_minimum = statistics.elevation_minimum;
+				elevation_maximum = statistics.elevation_maximum;
+				// the classification of the CPU is the reference, which the GPU should match exactly
+				if (verify_biomes) {
+					temperature_frame.fetch(temperature_map);
+					precipitation_frame.fetch(precipitation_map);
+					biome_differences = 0;
+					Lot<Color8u> reference(biome_map->getWidth());
+					for (int row = 0; row < biome_map->getHeight(); row++) {
+						signed2 start(0, row);
+						BiomeStatistics reference_statistics;
+						gpu_classifier->classify(elevation_map->getData(start), temperature_map->getData(start), precipitation_map->getData(start), reference.data(), reference.size(), reference_statistics);
+						auto classified = reinterpret_cast<const Color8u*>(biome_map->getData(start));
+						for (size_t column = 0; column < reference.size(); column++) {
+							if (not (classified[column] == reference[column])) biome_differences++;
+						}
+					}
+				}
+			}
+			if (not biome_map) return false;
+			dirty_stages[Display] = false;
+			// the displayed maps are refined until they have the full resolution
+			refine_resolution = resolution_divisor > 1;
+			// the preview of a zoom is replaced right away
+			if (not refine_elevation) store_stages();
+			return true;
+		}
+
+		bool WorldGenerationPipeline::restore(Stage stage) {
+			// the elevation is restored with full precision, unlike the temperature and the precipitation
+			if (stage <= Topography) quantized_inputs = false;
+			// stages reading restored maps produce other outputs than stages reading maps of full precision, so these are cached under another key
+			uint64 key = stage_key(stage, resolution_divisor);
+			uint64 quantized_key = (StageHash() << key << quantized_inputs).get();
+			stage_keys[stage] = quantized_inputs ? quantized_key : key;
+			// the job would replace the outputs of the following stages once it has finished
+			if (job) return false;
+			// outputs of full precision are preferred, e.g. those of the stage before its inputs were restored
+			auto outputs = cache.find(key);
+			if (outputs) stage_keys[stage] = key;
+			else if (quantized_inputs) outputs = cache.find(quantized_key);
+			if (not outputs) return false;
+			switch (stage) {
+				case Tectonic:
+					elevation_map = outputs->elevation_map;
+					elevation_buffer = elevation_source == CPU_Noise ? elevation_map : nullptr;
+					elevation_frame.set(Texture::create(*elevation_map));
+					break;
+				case Topography:
+					// the elevation changes only on the CPU, the temperatures of the GPU have been quantized to 8 bit by their copy like those of the CPU
+					if (outputs->elevation_map) elevation_map = outputs->elevation_map;
+					temperature_map = outputs->temperature_map;
+					temperature_frame.set(Texture::create(*temperature_map));
+					quantized_inputs = true;
+					break;
+				case Climate:
+					// the maps of the circulation are only kept to be displayed
+					circulation_map = outputs->circulation_map;
+					evapotranspiration_map = outputs->evapotranspiration_map;
+					humidity_map = outputs->humidity_map;
+					circulation_frame.discard();
+					evapotranspiration_frame.discard();
+					humidity_frame.discard();
+					precipitation_map = outputs->precipitation_map;
+					precipitation_frame.set(Texture::create(*precipitation_map));
+					quantized_inputs = true;
+					break;
+				case Biomes:
+					biome_map = outputs->biome_map;
+					water_pixels = outputs->water_pixels;
+					elevation_minimum = outputs->elevation_minimum;
+					elevation_maximum = outputs->elevation_maximum;
+					biome_frame.discard();
+					biome_differences = -1;
+					break;
+				default:
+					throw_runtime_exception();
+			}
+			return true;
+		}
+
+		void WorldGenerationPipeline::store_stages() {
+			for (Stage stage : { Tectonic, Topography, Climate, Biomes }) {
+				uint64 key = stage_keys[stage];
+				if (cache.contains(key)) continue;
+				auto outputs = make_shared<StageOutputs>();
+				switch (stage) {
+					case Tectonic:
+						outputs->elevation_map = elevation_source == CPU_Noise ? elevation_buffer : elevation_map;
+						if (not outputs->elevation_map) continue;
+						break;
+					case Topography:
+						if (elevation_source == CPU_Noise) outputs->elevation_map = elevation_map;
+						outputs->temperature_map = get_temperature_map();
+						if (not outputs->temperature_map) continue;
+						break;
+					case Climate:
+						if (circulation_type == Deflected) {
+							outputs->circulation_map = get_circulation_map();
+							outputs->evapotranspiration_map = get_evapotranspiration_map();
+							outputs->humidity_map = get_humidity_map();
+						}
+						outputs->precipitation_map = get_precipitation_map();
+						if (not outputs->precipitation_map) continue;
+						break;
+					default:
+						outputs->biome_map = biome_map;
+						outputs->water_pixels = water_pixels;
+						outputs->elevation_minimum = elevation_minimum;
+						outputs->elevation_maximum = elevation_maximum;
+				}
+				cache.insert(key, outputs);
+			}
+		}
+
+		shared<Channel> WorldGenerationPipeline::get_temperature_map() {
+			temperature_frame.fetch(temperature_map);
+			return temperature_map;
+		}
+
+		shared<Channel> WorldGenerationPipeline::get_evapotranspiration_map() {
+			evapotranspiration_frame.fetch(evapotranspiration_map);
+			return evapotranspiration_map;
+		}
+
+		shared<Surface> WorldGenerationPipeline::get_circulation_map() {
+			circulation_frame.fetch(circulation_map);
+			return circulation_map;
+		}
+
+		shared<Channel> WorldGenerationPipeline::get_humidity_map() {
+			humidity_frame.fetch(humidity_map);
+			return humidity_map;
+		}
+
+		shared<Channel> WorldGenerationPipeline::get_precipitation_map() {
+			precipitation_frame.fetch(precipitation_map);
+			return precipitation_map;
+		}
+
+	}
+
+}
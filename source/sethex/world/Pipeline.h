@@ -0,0 +1,184 @@
+#pragma once
+
+#include <memory>
+
+#include <cinder/utilities/Simplex.h>
+
+#include <sethex/Common.h>
+#include <sethex/Graphics.h>
+#include <sethex/Jobs.h>
+#include <sethex/world/Biomes.h>
+#include <sethex/world/Cache.h>
+#include <sethex/world/Frame.h>
+#include <sethex/world/Generation.h>
+#include <sethex/world/Stages.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Generates the maps of a world by a pipeline of stages, which run once they or a stage they depend on are dirty.
+		// The GPU parts of the stages run on the render thread and the CPU parts as a background job, which keeps the previous maps meanwhile.
+		// A pipeline owns its parameters, frames and maps, so several worlds can be generated at the same time, e.g. with different seeds.
+		// The settings and dirty flags are inherited, so the interface changes them directly.
+		class WorldGenerationPipeline : public GenerationSettings, public GenerationStages {
+
+		public:
+
+			static const int Seed_Maximum = 1000000000;
+
+			// elevation image, which is loaded as texture
+			struct ElevationMap {
+
+				shared<Texture> texture;
+				ci::fs::path path;
+
+				void load(const String& file_path);
+
+				bool loaded() const {
+					return texture != nullptr;
+				}
+
+			};
+
+			bool progressive = true;
+
+			// the biomes are classified by a shader if possible, the classifier is kept to verify its result against the CPU
+			bool gpu_biomes = true;
+			bool verify_biomes = false;
+
+			// outputs of previous settings, which are restored instead of running their stages again
+			StageCache cache;
+
+		private:
+
+			const unsigned2 full_resolution;
+
+			// accumulated navigation, which is applied by the next tectonic stage
+			signed2 drag;
+			float roll = 0.0f;
+			bool refine_elevation = false;
+
+			// the progressive generation runs the whole pipeline at a fraction of the resolution first and refines it afterwards
+			bool refine_resolution = false;
+			unsigned resolution_divisor = 1;
+			unsigned2 framebuffer_resolution;
+			bool available = false;
+
+			Simplex::Generator simplex;
+
+			ElevationMap height_map;
+			ElevationMap bathymetry_map;
+			ElevationMap topography_map;
+
+			Frame elevation_frame;
+			Frame temperature_frame;
+			Frame evapotranspiration_frame;
+			Frame circulation_frame;
+			Frame humidity_frame;
+			Frame precipitation_frame;
+			Frame biome_frame;
+
+			shared<Channel32f> elevation_buffer;
+			shared<Channel32f> elevation_map;
+			shared<Channel> temperature_map;
+			shared<Channel> evapotranspiration_map;
+			shared<Surface> circulation_map;
+			shared<Channel> humidity_map;
+			shared<Channel> precipitation_map;
+			shared<Surface> biome_map;
+			unsigned water_pixels = 0;
+			float elevation_minimum = 0.0f;
+			float elevation_maximum = 0.0f;
+
+			// changed settings cancel the job, since its results would be stale, and repeat its stages with the current settings
+			std::unique_ptr<Job> job;
+			shared<GenerationMaps> job_maps;
+			Stage job_restart = Tectonic;
+			Stage job_continuation = Stage_Count;
+			Lot<std::pair<String, double>> stage_timings;
+			// message of the exception which ended the last job, which keeps the previous maps
+			String failure;
+
+			shared<const BiomeClassifier> gpu_classifier;
+			int biome_differences = -1;
+
+			// keys of the current outputs of the stages
+			uint64 stage_keys[Display] = {};
+			// whether the following stages read temperatures or precipitations which were restored from 8 bit maps, instead of the 32 bit textures of the GPU
+			bool quantized_inputs = false;
+
+			// hashes the inputs of a stage and the stages it depends on
+			uint64 stage_key(Stage stage, unsigned resolution_divisor) const {
+				return key(*this, stage, full_resolution, resolution_divisor);
+			}
+
+			bool restore(Stage stage);
+			void store_stages();
+
+			bool all_compiled();
+			void load_resources();
+			void finish_job();
+			void schedule_stages();
+			void start_job();
+			bool complete_display();
+
+		public:
+
+			explicit WorldGenerationPipeline(bool high_resolution = false);
+
+			// the frames and the job refer to the pipeline
+			WorldGenerationPipeline(const WorldGenerationPipeline&) = delete;
+			WorldGenerationPipeline& operator=(const WorldGenerationPipeline&) = delete;
+
+			// shifts the section by "drag" pixels and zooms by "roll", which accumulate while a job is running
+			void navigate(signed2 drag, float roll);
+
+			// runs the dirty stages on the render thread, returns true once new maps should be displayed
+			bool update();
+
+			// whether the shaders are compiled and the elevation maps are loaded
+			bool resources_available() const {
+				return available;
+			}
+
+			const ElevationMap& get_height_map() const { return height_map; }
+			const ElevationMap& get_bathymetry_map() const { return bathymetry_map; }
+			const ElevationMap& get_topography_map() const { return topography_map; }
+
+			// running job or nullptr, e.g. to show its progress
+			const Job* get_job() const {
+				return job.get();
+			}
+
+			// seconds of the stages of the last finished job
+			const Lot<std::pair<String, double>>& get_stage_timings() const {
+				return stage_timings;
+			}
+
+			// message of the exception of the last job or empty if it hasn't failed
+			const String& get_failure() const {
+				return failure;
+			}
+
+			// the maps of the GPU are copied once they are requested
+			shared<Channel32f> get_elevation_map() { return elevation_map; }
+			shared<Channel> get_temperature_map();
+			shared<Channel> get_evapotranspiration_map();
+			shared<Surface> get_circulation_map();
+			shared<Channel> get_humidity_map();
+			shared<Channel> get_precipitation_map();
+			shared<Surface> get_biome_map() { return biome_map; }
+
+			unsigned get_water_pixels() const { return water_pixels; }
+			float get_elevation_minimum() const { return elevation_minimum; }
+			float get_elevation_maximum() const { return elevation_maximum; }
+
+			// pixels of the GPU classification which differ from the CPU, -1 if they haven't been verified
+			int get_biome_differences() const { return biome_differences; }
+
+		};
+
+	}
+
+}
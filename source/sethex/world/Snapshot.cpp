@@ -0,0 +1,249 @@
+#include "Snapshot.h"
+
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <utilities/Exceptions.h>
+#include <utilities/Mathematics.h>
+
+using namespace cinder;
+using namespace std;
+
+namespace tenjix {
+
+	namespace sethex {
+
+		namespace {
+
+			const char Snapshot_Signature[4] = { 'S', 'X', 'W', 'S' };
+
+			uint64 align(uint64 offset) {
+				return (offset + WorldSnapshot::Layer_Alignment - 1) / WorldSnapshot::Layer_Alignment * WorldSnapshot::Layer_Alignment;
+			}
+
+			// writes zeros up to the next layer boundary and returns the offset of the layer
+			uint64 pad(ostream& stream) {
+				uint64 offset = static_cast<uint64>(stream.tellp());
+				uint64 aligned = align(offset);
+				static const char zeros[WorldSnapshot::Layer_Alignment] = {};
+				stream.write(zeros, aligned - offset);
+				return aligned;
+			}
+
+			// whether "size" bytes from "offset" end before "end", without overflowing
+			bool fits(uint64 offset, uint64 size, uint64 end) {
+				return offset <= end and size <= end - offset;
+			}
+
+			template<class Type>
+			void write_rows(ostream& stream, const ChannelT<Type>& map) {
+				for (int row = 0; row < map.getHeight(); row++) {
+					stream.write(reinterpret_cast<const char*>(map.getData(signed2(0, row))), map.getWidth() * sizeof(Type));
+				}
+			}
+
+		}
+
+		// definitions of the constants, which are bound to references by the messages of exceptions
+		const uint32 WorldSnapshot::Version;
+		const uint64 WorldSnapshot::Layer_Alignment;
+
+		// read only view of a file, whose pages are copied once they are written to
+		class WorldSnapshot::Mapping {
+
+			#ifdef _WIN32
+			HANDLE file = INVALID_HANDLE_VALUE;
+			HANDLE mapping = nullptr;
+			#endif
+
+			void release() {
+				#ifdef _WIN32
+				if (data) UnmapViewOfFile(data);
+				if (mapping) CloseHandle(mapping);
+				if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+				mapping = nullptr;
+				file = INVALID_HANDLE_VALUE;
+				#else
+				if (data) munmap(data, size);
+				#endif
+				data = nullptr;
+			}
+
+		public:
+
+			uint8* data = nullptr;
+			uint64 size = 0;
+
+			explicit Mapping(const fs::path& path) {
+				#ifdef _WIN32
+				file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (file == INVALID_HANDLE_VALUE) throw_runtime_exception("can't open world snapshot '", path, "'");
+				LARGE_INTEGER file_size;
+				GetFileSizeEx(file, &file_size);
+				size = static_cast<uint64>(file_size.QuadPart);
+				mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+				if (mapping) data = static_cast<uint8*>(MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+				#else
+				int file = open(path.c_str(), O_RDONLY);
+				if (file < 0) throw_runtime_exception("can't open world snapshot '", path, "'");
+				struct stat status;
+				fstat(file, &status);
+				size = static_cast<uint64>(status.st_size);
+				if (size > 0) {
+					void* mapped = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+					if (mapped != MAP_FAILED) data = static_cast<uint8*>(mapped);
+				}
+				close(file);
+				#endif
+				if (not data) {
+					release();
+					throw_runtime_exception("can't map world snapshot '", path, "'");
+				}
+			}
+
+			~Mapping() {
+				release();
+			}
+
+			Mapping(const Mapping&) = delete;
+			Mapping& operator=(const Mapping&) = delete;
+
+		};
+
+		void WorldSnapshot::write(const fs::path& path, const WorldParameters& parameters, const Channel32f& elevation_map, const Channel& temperature_map,
+			const Channel& precipitation_map, const Surface& biome_map, Elevation_Format elevation_format) {
+			signed2 size = elevation_map.getSize();
+			if (temperature_map.getSize() != size or precipitation_map.getSize() != size or biome_map.getSize() != size) throw_runtime_exception("the maps of a world snapshot differ in size");
+			ostringstream parameter_lines;
+			parameters.write(parameter_lines);
+			String parameter_text = parameter_lines.str();
+
+			if (path.has_parent_path()) fs::create_directories(path.parent_path());
+			ofstream stream(path.string(), ios::binary);
+			if (not stream) throw_runtime_exception("can't create world snapshot '", path, "'");
+
+			// the header is written again once the offsets are known
+			Header header = {};
+			copy(begin(Snapshot_Signature), end(Snapshot_Signature), header.signature);
+			header.version = Version;
+			header.width = size.x;
+			header.height = size.y;
+			header.elevation_format = elevation_format;
+			header.layer_count = Layer_Count;
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			header.parameters_offset = sizeof(header);
+			header.parameters_size = parameter_text.size();
+			stream.write(parameter_text.data(), parameter_text.size());
+
+			header.layer_offsets[Elevation] = pad(stream);
+			if (elevation_format == Int16) {
+				Lot<int16_t> quantized(size.x);
+				for (int row = 0; row < size.y; row++) {
+					auto elevations = elevation_map.getData(signed2(0, row));
+					for (int column = 0; column < size.x; column++) {
+						quantized[column] = static_cast<int16_t>(round(clamp(elevations[column], -1.0f, 1.0f) * 32767.0f));
+					}
+					stream.write(reinterpret_cast<const char*>(quantized.data()), quantized.size() * sizeof(int16_t));
+				}
+			} else {
+				write_rows(stream, elevation_map);
+			}
+			header.layer_offsets[Temperature] = pad(stream);
+			write_rows(stream, temperature_map);
+			header.layer_offsets[Precipitation] = pad(stream);
+			write_rows(stream, precipitation_map);
+			header.layer_offsets[Biome_Ids] = pad(stream);
+			Channel biome_ids(size.x, size.y);
+			auto biome_iterator = biome_map.getIter();
+			auto id_iterator = biome_ids.getIter();
+			while (biome_iterator.line() and id_iterator.line()) {
+				while (biome_iterator.pixel() and id_iterator.pixel()) {
+					id_iterator.v() = parameters.biome_colors.get_id(Color8u(biome_iterator.r(), biome_iterator.g(), biome_iterator.b()));
+				}
+			}
+			write_rows(stream, biome_ids);
+
+			stream.seekp(0);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			if (not stream) throw_runtime_exception("couldn't write world snapshot '", path, "'");
+		}
+
+		WorldSnapshot::WorldSnapshot(const fs::path& path)
+			: mapping(make_shared<Mapping>(path)) {
+			if (mapping->size < sizeof(Header)) throw_runtime_exception("'", path, "' isn't a world snapshot");
+			header = reinterpret_cast<const Header*>(mapping->data);
+			if (not equal(begin(Snapshot_Signature), end(Snapshot_Signature), header->signature)) throw_runtime_exception("'", path, "' isn't a world snapshot");
+			if (header->version != Version) throw_runtime_exception("world snapshot '", path, "' has version ", header->version, " instead of ", Version);
+			if (header->layer_count != Layer_Count or header->elevation_format > Int16) throw_runtime_exception("world snapshot '", path, "' is invalid");
+			// the maps are created with int extents and rows of floats, whose bytes have to fit into an int as well
+			uint32 maximum_extent = numeric_limits<int32>::max() / sizeof(float);
+			if (header->width == 0 or header->height == 0 or header->width > maximum_extent or header->height > maximum_extent) throw_runtime_exception("world snapshot '", path, "' is invalid");
+			// the last layer ends the file, the previous ones are followed by their successor
+			// the layers are smaller than the file if it's valid, so bounding the pixels by the file keeps the sizes from overflowing
+			uint64 pixels = static_cast<uint64>(header->width) * header->height;
+			bool valid = pixels <= mapping->size / sizeof(float);
+			uint64 elevation_size = pixels * (header->elevation_format == Int16 ? sizeof(int16_t) : sizeof(float));
+			valid = valid and fits(header->parameters_offset, header->parameters_size, header->layer_offsets[Elevation])
+				and fits(header->layer_offsets[Elevation], elevation_size, header->layer_offsets[Temperature])
+				and fits(header->layer_offsets[Temperature], pixels, header->layer_offsets[Precipitation])
+				and fits(header->layer_offsets[Precipitation], pixels, header->layer_offsets[Biome_Ids])
+				and fits(header->layer_offsets[Biome_Ids], pixels, mapping->size);
+			for (auto offset : header->layer_offsets) valid = valid and offset % Layer_Alignment == 0;
+			if (not valid) throw_runtime_exception("world snapshot '", path, "' is truncated");
+			istringstream parameter_lines(String(reinterpret_cast<const char*>(mapping->data + header->parameters_offset), header->parameters_size));
+			parameters.read(parameter_lines);
+		}
+
+		uint8* WorldSnapshot::layer(Layer layer) const {
+			return mapping->data + header->layer_offsets[layer];
+		}
+
+		shared<Channel32f> WorldSnapshot::get_elevation_map() const {
+			int width = header->width, height = header->height;
+			if (header->elevation_format == Int16) {
+				auto quantized = reinterpret_cast<const int16_t*>(layer(Elevation));
+				auto elevation_map = Channel32f::create(width, height);
+				for (int row = 0; row < height; row++) {
+					auto elevations = elevation_map->getData(signed2(0, row));
+					for (int column = 0; column < width; column++) {
+						elevations[column] = quantized[static_cast<size_t>(row) * width + column] / 32767.0f;
+					}
+				}
+				return elevation_map;
+			}
+			auto data = reinterpret_cast<float*>(layer(Elevation));
+			return shared<Channel32f>(new Channel32f(width, height, width * sizeof(float), 1, data), [mapping = mapping](Channel32f* map) { delete map; });
+		}
+
+		shared<Channel> WorldSnapshot::get_temperature_map() const {
+			int width = header->width, height = header->height;
+			return shared<Channel>(new Channel(width, height, width, 1, layer(Temperature)), [mapping = mapping](Channel* map) { delete map; });
+		}
+
+		shared<Channel> WorldSnapshot::get_precipitation_map() const {
+			int width = header->width, height = header->height;
+			return shared<Channel>(new Channel(width, height, width, 1, layer(Precipitation)), [mapping = mapping](Channel* map) { delete map; });
+		}
+
+		shared<Channel> WorldSnapshot::get_biome_ids() const {
+			int width = header->width, height = header->height;
+			return shared<Channel>(new Channel(width, height, width, 1, layer(Biome_Ids)), [mapping = mapping](Channel* map) { delete map; });
+		}
+
+	}
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <sethex/Common.h>
+#include <sethex/Images.h>
+#include <sethex/world/Generation.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		// Versioned binary file of a generated world, which contains its size, parameters and maps.
+		// The layers start at page boundaries and their rows are contiguous, so they are used from a memory mapping of the file without parsing.
+		// Layout: header, parameters as lines of "name = value", elevation (float or int16), temperature, precipitation and biome ids (uint8).
+		class WorldSnapshot {
+
+		public:
+
+			enum Elevation_Format : uint32 { Float32, Int16 };
+
+			enum Layer { Elevation, Temperature, Precipitation, Biome_Ids, Layer_Count };
+
+			static const uint32 Version = 1;
+
+			// alignment of the layers, which is the size of a page on common platforms
+			static const uint64 Layer_Alignment = 4096;
+
+			struct Header {
+				char signature[4];
+				uint32 version;
+				uint32 width;
+				uint32 height;
+				uint32 elevation_format;
+				uint32 layer_count;
+				uint64 parameters_offset;
+				uint64 parameters_size;
+				uint64 layer_offsets[Layer_Count];
+			};
+
+		private:
+
+			class Mapping;
+
+			shared<Mapping> mapping;
+			const Header* header = nullptr;
+			WorldParameters parameters;
+
+			uint8* layer(Layer layer) const;
+
+		public:
+
+			// writes the maps of a world, whose elevations [-1, +1] may be quantized to int16 to halve the size of the file
+			// the biome colors are stored as their compact ids, throws a runtime exception if the file can't be written
+			static void write(const ci::fs::path& path, const WorldParameters& parameters, const Channel32f& elevation_map, const Channel& temperature_map,
+				const Channel& precipitation_map, const Surface& biome_map, Elevation_Format elevation_format = Float32);
+
+			// maps the file into the memory, throws a runtime exception if it isn't a snapshot of this version or is truncated
+			explicit WorldSnapshot(const ci::fs::path& path);
+
+			unsigned2 get_size() const {
+				return { header->width, header->height };
+			}
+
+			Elevation_Format get_elevation_format() const {
+				return static_cast<Elevation_Format>(header->elevation_format);
+			}
+
+			const WorldParameters& get_parameters() const {
+				return parameters;
+			}
+
+			// the maps refer to the mapping and keep it alive, they are copied on write, so changes don't reach the file
+			// quantized elevations are converted into a new map
+			shared<Channel32f> get_elevation_map() const;
+			shared<Channel> get_temperature_map() const;
+			shared<Channel> get_precipitation_map() const;
+			shared<Channel> get_biome_ids() const;
+
+		};
+
+	}
+
+}
@@ -0,0 +1,40 @@
+#include "Stages.h"
+
+#include <sethex/world/Cache.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		uint64 GenerationStages::key(const GenerationSettings& settings, Stage stage, unsigned2 resolution, unsigned resolution_divisor) {
+			auto& parameters = settings.parameters;
+			// the inputs are appended stage by stage, so the key of a stage depends on the inputs of the previous ones
+			StageHash hash;
+			hash << resolution << resolution_divisor << settings.elevation_source;
+			if (settings.elevation_source == Elevation_Map) {
+				hash << settings.height_file << settings.height_scale;
+			} else if (settings.elevation_source == Elevation_Maps) {
+				hash << settings.bathymetry_file << settings.bathymetry_scale << settings.topography_file << settings.topography_scale;
+			} else {
+				hash << parameters.seed << parameters.scale << parameters.shift << parameters.options << parameters.wrap_horizontally;
+				hash << parameters.use_continents << parameters.continent_frequency << parameters.continent_amplitude;
+			}
+			hash << parameters.equator_distance_factor << parameters.equator_distance_power;
+			if (stage == Tectonic) return hash.get();
+			hash << settings.circulation_type << parameters.sealevel << parameters.equator << parameters.maximum_elevation;
+			hash << parameters.maximum_temperature << parameters.minimum_temperature << parameters.lapse_rate;
+			if (stage == Topography) return hash.get();
+			hash << parameters.evaporation_factor << parameters.transpiration_factor << parameters.precipitation_factor << parameters.precipitation_decay;
+			hash << parameters.humidity_saturation << parameters.upper_precipitation << parameters.circulation_iterations;
+			hash << parameters.circulation_intensity << parameters.precipitation_intensity << parameters.orograpic_effect << settings.debug_circulation;
+			if (stage == Climate) return hash.get();
+			auto& colors = parameters.biome_colors;
+			hash << parameters.biome_determination << parameters.lower_threshold << parameters.upper_threshold << parameters.thresholds;
+			hash << colors.ice << colors.tundra << colors.taiga << colors.steppe << colors.prairie << colors.forest << colors.desert << colors.savanna;
+			hash << colors.rainforest << colors.hot_rock << colors.rock << colors.cold_rock << colors.beach << colors.coast << colors.ocean << colors.deep_ocean;
+			return hash.get();
+		}
+
+	}
+
+}
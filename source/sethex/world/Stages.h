@@ -0,0 +1,77 @@
+#pragma once
+
+#include <sethex/Common.h>
+#include <sethex/world/Generation.h>
+
+namespace tenjix {
+
+	namespace sethex {
+
+		enum Elevation_Source { CPU_Noise, GPU_Noise, Elevation_Maps, Elevation_Map };
+		enum Circulation_Type { Linear, Deflected };
+
+		// settings of a pipeline, which should invalidate the stages depending on them once changed
+		struct GenerationSettings {
+
+			// parameters of the generation, which are copied into the stages of a job
+			WorldParameters parameters;
+
+			int elevation_source = GPU_Noise;
+			int circulation_type = Deflected;
+			String height_file;
+			String bathymetry_file;
+			String topography_file;
+			float height_scale = 1.0f;
+			float bathymetry_scale = 1.0f;
+			float topography_scale = 1.0f;
+			bool debug_circulation = false;
+
+		};
+
+		// Dirty flags of the stages of the world generation, which run once they or a stage they depend on are dirty.
+		// They don't depend on a graphics context, unlike the pipeline running the stages.
+		class GenerationStages {
+
+		public:
+
+			// stages of the generation, each depends on the previous one and the display depends on the biomes
+			enum Stage { Tectonic, Topography, Climate, Biomes, Display, Stage_Count };
+
+			// the stage which needs the results of a stage and becomes dirty once it has run
+			static Stage dependent(Stage stage) {
+				return stage == Display ? Display : static_cast<Stage>(stage + 1);
+			}
+
+			// hashes the inputs of a stage and the stages it depends on, which are generated with "resolution" divided by "resolution_divisor"
+			static uint64 key(const GenerationSettings& settings, Stage stage, unsigned2 resolution, unsigned resolution_divisor);
+
+		protected:
+
+			bool dirty_stages[Stage_Count] = { true, false, false, false, false };
+
+		public:
+
+			// flag of a stage, which can be set to run the stage and its dependents again
+			bool& dirty(Stage stage) {
+				return dirty_stages[stage];
+			}
+
+			bool dirty(Stage stage) const {
+				return dirty_stages[stage];
+			}
+
+			void complete(Stage stage) {
+				dirty_stages[stage] = false;
+				dirty_stages[dependent(stage)] = true;
+			}
+
+			// whether a stage producing maps is dirty, unlike the display
+			bool settings_changed() const {
+				return dirty_stages[Tectonic] or dirty_stages[Topography] or dirty_stages[Climate] or dirty_stages[Biomes];
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <utilities/Standard.h>
+
+// Compile-time logging level (0 = trace, 1 = debug, 2 = none), which can be overridden by defining "TENJIX_LOGGING_LEVEL".
+// Release builds default to the debug level, so trace calls including the formatting of their arguments are compiled out.
+#ifndef TENJIX_LOGGING_LEVEL
+	#ifdef NDEBUG
+		#define TENJIX_LOGGING_LEVEL 1
+	#else
+		#define TENJIX_LOGGING_LEVEL 0
+	#endif
+#endif
+
+namespace tenjix {
+
+	enum class Logging_Level { Trace, Debug, None };
+
+	constexpr Logging_Level logging_level = static_cast<Logging_Level>(TENJIX_LOGGING_LEVEL);
+
+	// Determines whether messages of the given level are logged.
+	constexpr bool logging(Logging_Level level) {
+		return level >= logging_level;
+	}
+
+}
+
+// The macros are selected by the preprocessor instead of a constant condition, which would warn at high warning levels (C4127).
+// A disabled macro expands to an empty statement, so its arguments are neither evaluated nor stringified.
+#if TENJIX_LOGGING_LEVEL <= 0
+	#define TENJIX_TRACE(...) trace(__VA_ARGS__)
+#else
+	#define TENJIX_TRACE(...) static_cast<void>(0)
+#endif
+
+#if TENJIX_LOGGING_LEVEL <= 1
+	#define TENJIX_DEBUG(...) debug(__VA_ARGS__)
+#else
+	#define TENJIX_DEBUG(...) static_cast<void>(0)
+#endif
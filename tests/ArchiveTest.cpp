@@ -0,0 +1,152 @@
+#include <fstream>
+
+#include <sethex/world/Archive.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace cinder;
+using namespace std;
+
+namespace {
+
+	// the chunks at the right and bottom border are smaller than the others
+	const int Width = 45, Height = 21;
+	const unsigned Chunk_Size = 16;
+
+	float elevation(int x, int y) {
+		return (x * 7 % 23 - y) / 32.0f;
+	}
+
+	void write_archive(const fs::path& path) {
+		WorldParameters parameters;
+		parameters.seed = 5;
+		Channel32f elevation_map(Width, Height);
+		Channel temperature_map(Width, Height), precipitation_map(Width, Height);
+		Surface biome_map(Width, Height, false);
+		auto biomes = biome_map.getIter();
+		while (biomes.line()) while (biomes.pixel()) {
+			elevation_map.setValue(biomes.getPos(), elevation(biomes.x(), biomes.y()));
+			temperature_map.setValue(biomes.getPos(), static_cast<uint8>(biomes.x() * 5));
+			precipitation_map.setValue(biomes.getPos(), static_cast<uint8>(255 - biomes.y()));
+			auto color = biomes.y() < Height / 2 ? parameters.biome_colors.taiga : parameters.biome_colors.coast;
+			biomes.r() = color.r;
+			biomes.g() = color.g;
+			biomes.b() = color.b;
+		}
+		WorldArchive::write(path, parameters, elevation_map, temperature_map, precipitation_map, biome_map, Chunk_Size);
+	}
+
+	void test_round_trip(const fs::path& path) {
+		write_archive(path);
+		WorldArchive archive(path);
+		CHECK(archive.get_size() == unsigned2(Width, Height));
+		CHECK(archive.get_parameters().seed == 5);
+		archive.set_capacity(2);
+		unsigned differences = 0;
+		auto& colors = archive.get_parameters().biome_colors;
+		for (int y = 0; y < Height; y++) {
+			for (int x = 0; x < Width; x++) {
+				signed2 pixel(x, y);
+				differences += abs(archive.get_elevation(pixel) - elevation(x, y)) > 1.0f / 32767;
+				differences += archive.get_temperature(pixel) != static_cast<uint8>(x * 5);
+				differences += archive.get_precipitation(pixel) != static_cast<uint8>(255 - y);
+				differences += archive.get_biome_id(pixel) != colors.get_id(y < Height / 2 ? colors.taiga : colors.coast);
+			}
+		}
+		CHECK(differences == 0);
+		// pixels outside of the map are clamped
+		CHECK(archive.get_temperature(signed2(Width + 5, -3)) == static_cast<uint8>((Width - 1) * 5));
+		CHECK(archive.get_decoded_size() == static_cast<uint64>(Width) * Height * (sizeof(float) + 3));
+		CHECK(archive.get_compressed_size() > 0);
+	}
+
+	template<class Type>
+	Type read_at(const fs::path& path, uint64 offset) {
+		Type value;
+		ifstream stream(path.string(), ios::binary);
+		stream.seekg(offset);
+		stream.read(reinterpret_cast<char*>(&value), sizeof(value));
+		return value;
+	}
+
+	template<class Type>
+	void write_at(const fs::path& path, uint64 offset, const Type& value) {
+		fstream stream(path.string(), ios::binary | ios::in | ios::out);
+		stream.seekp(offset);
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	// a corrupt chunk throws each time it's sampled and doesn't affect the other chunks
+	void test_corrupt_chunk(const fs::path& path) {
+		write_archive(path);
+		auto header = read_at<WorldArchive::Header>(path, 0);
+		// the first chunk of the elevation, whose first token is replaced by one of a match preceding any output
+		auto location = read_at<WorldArchive::Index>(path, header.index_offset);
+		write_at<uint16>(path, location.offset, 0x0F00);
+		WorldArchive archive(path);
+		for (int attempt = 0; attempt < 2; attempt++) {
+			bool thrown = false;
+			try {
+				archive.get_elevation(signed2(0, 0));
+			} catch (const exception&) {
+				thrown = true;
+			}
+			CHECK(thrown);
+		}
+		CHECK(abs(archive.get_elevation(signed2(Width - 1, Height - 1)) - elevation(Width - 1, Height - 1)) <= 1.0f / 32767);
+		CHECK(archive.get_temperature(signed2(0, 0)) == 0);
+	}
+
+	// whether opening the archive throws once its header has been changed
+	template<class Change>
+	bool rejects(const fs::path& path, Change change) {
+		write_archive(path);
+		auto header = read_at<WorldArchive::Header>(path, 0);
+		change(header);
+		write_at(path, 0, header);
+		try {
+			WorldArchive archive(path);
+		} catch (const exception&) {
+			return true;
+		}
+		return false;
+	}
+
+	void test_validation(const fs::path& path) {
+		using Header = WorldArchive::Header;
+		CHECK(not rejects(path, [](Header&) {}));
+		CHECK(rejects(path, [](Header& header) { header.signature[0] = 'X'; }));
+		CHECK(rejects(path, [](Header& header) { header.width = 0; }));
+		CHECK(rejects(path, [](Header& header) { header.height = 0xFFFFFFFF; }));
+		CHECK(rejects(path, [](Header& header) { header.chunk_size = 0; }));
+		CHECK(rejects(path, [](Header& header) { header.chunk_size = WorldArchive::Maximum_Chunk_Size + 1; }));
+		// an index larger than the file, which would be allocated otherwise
+		CHECK(rejects(path, [](Header& header) { header.width = header.height = 0x7FFFFFFF; header.chunk_size = 1; }));
+		CHECK(rejects(path, [](Header& header) { header.parameters_size = 0xFFFFFFFFFFFFFFFFull; }));
+		CHECK(rejects(path, [](Header& header) { header.index_offset = 0xFFFFFFFFFFFFFFF0ull; }));
+
+		// an index entry beyond the file
+		write_archive(path);
+		auto header = read_at<WorldArchive::Header>(path, 0);
+		write_at(path, header.index_offset + sizeof(WorldArchive::Index), WorldArchive::Index { 16, 0xFFFFFFFFFFFFFFFFull });
+		bool thrown = false;
+		try {
+			WorldArchive archive(path);
+		} catch (const exception&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+	}
+
+}
+
+int main() {
+	auto path = fs::temp_directory_path() / "sethex-archive-test.archive";
+	test_round_trip(path);
+	test_corrupt_chunk(path);
+	test_validation(path);
+	fs::remove(path);
+	return testing::result();
+}
@@ -0,0 +1,85 @@
+#include <cstring>
+#include <random>
+
+#include <hexagonal/Map.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	// odd, so the vectorized conversions also leave a remainder to the scalar ones
+	const size_t Count = 100003;
+
+	template <class Type>
+	bool identical(const Lot<Type>& one, const Lot<Type>& other) {
+		return one.size() == other.size() and memcmp(one.data(), other.data(), one.size() * sizeof(Type)) == 0;
+	}
+
+	Lot<Cell> random_cells(mt19937& random) {
+		uniform_int_distribution<int32> coordinate(-(1 << 20), 1 << 20), small(-3, 3);
+		Lot<Cell> cells(Count);
+		for (size_t index = 0; index < Count; index++) {
+			cells[index] = index % 2 ? Cell(coordinate(random), coordinate(random)) : Cell(small(random), small(random));
+		}
+		return cells;
+	}
+
+	// the batch conversions of cells equal those of single cells bit by bit
+	void test_cells(mt19937& random) {
+		auto cells = random_cells(random);
+		hex::Map map(2048, 1024, false);
+		for (auto handedness : { Handedness::Left, Handedness::Right }) {
+			Lot<float2> cartesian(Count), expected_cartesian(Count);
+			Lot<float3> positions(Count), expected_positions(Count);
+			batch::to_cartesian(cells.data(), cartesian.data(), Count, handedness);
+			batch::to_positions(cells.data(), positions.data(), Count, handedness);
+			for (size_t index = 0; index < Count; index++) {
+				expected_cartesian[index] = cells[index].to_cartesian(handedness);
+				expected_positions[index] = cells[index].to_position(handedness);
+			}
+			CHECK(identical(cartesian, expected_cartesian));
+			CHECK(identical(positions, expected_positions));
+		}
+		Lot<float2> texinates(Count), expected_texinates(Count);
+		map.texinates(cells.data(), texinates.data(), Count);
+		for (size_t index = 0; index < Count; index++) expected_texinates[index] = map.texinates(cells[index]);
+		CHECK(identical(texinates, expected_texinates));
+	}
+
+	// the batch calculation of cells equals that of single cells, also for coordinates halfway between two cells
+	void test_cells_of(mt19937& random) {
+		auto cells = random_cells(random);
+		uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+		for (auto handedness : { Handedness::Left, Handedness::Right }) {
+			Lot<float2> cartesian(Count);
+			Lot<float3> positions(Count);
+			for (size_t index = 0; index < Count; index++) {
+				auto center = cells[index].to_cartesian(handedness);
+				auto neighbor = (cells[index] + Cell(1, 0)).to_cartesian(handedness);
+				cartesian[index] = index % 3 ? center + float2(jitter(random), jitter(random)) : 0.5f * (center + neighbor);
+				positions[index] = float3(cartesian[index].x, jitter(random), cartesian[index].y);
+			}
+			Lot<Cell> of_cartesian(Count), expected_of_cartesian(Count), of_positions(Count), expected_of_positions(Count);
+			batch::cells_of(cartesian.data(), of_cartesian.data(), Count, handedness);
+			batch::cells_of(positions.data(), of_positions.data(), Count, handedness);
+			for (size_t index = 0; index < Count; index++) {
+				expected_of_cartesian[index] = Cell::of(cartesian[index], handedness);
+				expected_of_positions[index] = Cell::of(positions[index], handedness);
+			}
+			CHECK(identical(of_cartesian, expected_of_cartesian));
+			CHECK(identical(of_positions, expected_of_positions));
+		}
+	}
+
+}
+
+int main() {
+	mt19937 random(7);
+	test_cells(random);
+	test_cells_of(random);
+	return testing::result();
+}
@@ -0,0 +1,82 @@
+#include <cstdlib>
+
+#include <cinder/app/App.h>
+#include <cinder/app/RendererGl.h>
+
+#include <sethex/world/Pipeline.h>
+
+using namespace cinder;
+using namespace cinder::app;
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace std;
+
+// Generates the presets with both biome determinations and compares the biomes classified by the shader with those of the CPU.
+// It's an application, since the pipeline needs a graphics context, which exits with a non-zero code once a classification differs.
+class BiomesGpuTest : public App {
+
+	// frames after which a generation counts as failed
+	static const unsigned Frame_Limit = 1000;
+
+	unique_ptr<WorldGenerationPipeline> pipeline;
+	unsigned preset = 0;
+	int determination = Elevation_Based;
+	unsigned frames = 0;
+	unsigned failures = 0;
+
+	// each generation uses a new pipeline, so its stages aren't restored from the cache
+	void start() {
+		pipeline = make_unique<WorldGenerationPipeline>();
+		pipeline->progressive = false;
+		pipeline->gpu_biomes = true;
+		pipeline->verify_biomes = true;
+		pipeline->parameters.apply_preset(preset, false);
+		pipeline->parameters.biome_determination = determination;
+		frames = 0;
+	}
+
+	void finish(bool failed) {
+		if (failed) failures++;
+		if (determination == Elevation_Based) {
+			determination = Climate_Based;
+		} else {
+			determination = Elevation_Based;
+			preset++;
+		}
+		if (preset < WorldParameters::preset_list.size()) return start();
+		print(failures, " of ", 2 * WorldParameters::preset_list.size(), " generations failed");
+		exit(failures ? EXIT_FAILURE : EXIT_SUCCESS);
+	}
+
+public:
+
+	void setup() override {
+		start();
+	}
+
+	void update() override {
+		auto name = WorldParameters::preset_list[preset] + (determination == Elevation_Based ? " (elevation based)" : " (climate based)");
+		if (pipeline->update()) {
+			// the differences are -1 if the biomes haven't been classified by the shader
+			int differences = pipeline->get_biome_differences();
+			print(name, ": ", differences, " differing pixels");
+			finish(differences != 0);
+		} else if (not pipeline->get_failure().empty()) {
+			print(name, ": ", pipeline->get_failure());
+			finish(true);
+		} else if (++frames > Frame_Limit) {
+			print(name, ": not generated after ", Frame_Limit, " frames");
+			finish(true);
+		}
+	}
+
+	void draw() override {
+		gl::clear();
+	}
+
+};
+
+CINDER_APP(BiomesGpuTest, RendererGl(RendererGl::Options().version(4, 5)), [](App::Settings* settings) {
+	settings->setWindowSize(320, 180);
+	settings->disableFrameRate();
+})
@@ -0,0 +1,81 @@
+#include <random>
+
+#include <sethex/world/Generation.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace std;
+
+namespace {
+
+	const size_t Count = 4099;
+
+	// classifies random pixels and compares the classifier with the determination and its statistics with those of measure
+	void test_classifier(const WorldParameters& parameters) {
+		auto determination = parameters.get_biome_determination();
+		BiomeClassifier classifier(determination, [&](uint8 temperature) { return parameters.normalize_temperature(temperature); });
+		mt19937 random(parameters.biome_determination);
+		uniform_real_distribution<float> elevation_distribution(-1.0f, 1.0f);
+		uniform_int_distribution<int> value_distribution(0, 255);
+		Lot<float> elevations(Count);
+		Lot<uint8> temperatures(Count), precipitations(Count);
+		for (size_t index = 0; index < Count; index++) {
+			elevations[index] = elevation_distribution(random);
+			temperatures[index] = static_cast<uint8>(value_distribution(random));
+			precipitations[index] = static_cast<uint8>(value_distribution(random));
+		}
+		// the bounds themselves belong to the band below
+		elevations[0] = parameters.sealevel;
+		elevations[1] = parameters.sealevel + parameters.thresholds.coast;
+		elevations[2] = parameters.sealevel - 0.25f;
+
+		Lot<ci::Color8u> biomes(Count);
+		BiomeStatistics classified;
+		classifier.classify(elevations.data(), temperatures.data(), precipitations.data(), biomes.data(), Count, classified);
+		BiomeStatistics measured;
+		classifier.measure(elevations.data(), Count, measured);
+		CHECK(classified.water_pixels == measured.water_pixels);
+		CHECK(classified.elevation_minimum == measured.elevation_minimum);
+		CHECK(classified.elevation_maximum == measured.elevation_maximum);
+
+		unsigned differences = 0, water_pixels = 0;
+		for (size_t index = 0; index < Count; index++) {
+			auto expected = determination(elevations[index], parameters.normalize_temperature(temperatures[index]), precipitations[index] / 255.0f);
+			differences += biomes[index] != expected;
+			auto& colors = determination.colors;
+			water_pixels += expected == colors.coast or expected == colors.ocean or expected == colors.deep_ocean;
+		}
+		CHECK(differences == 0);
+		CHECK(measured.water_pixels == water_pixels);
+		CHECK(measured.water_pixels > 0 and measured.water_pixels < Count);
+	}
+
+	// the water is counted by the elevation, so a land biome with the color of water doesn't count
+	void test_equal_colors() {
+		WorldParameters parameters;
+		parameters.biome_determination = Elevation_Based;
+		parameters.biome_colors.prairie = parameters.biome_colors.coast;
+		BiomeClassifier classifier(parameters.get_biome_determination(), [&](uint8 temperature) { return parameters.normalize_temperature(temperature); });
+		float elevations[] { parameters.sealevel + parameters.thresholds.prairie + 0.01f, parameters.sealevel + parameters.thresholds.coast + 0.01f, -1.0f };
+		BiomeStatistics statistics;
+		classifier.measure(elevations, 3, statistics);
+		CHECK(statistics.water_pixels == 2);
+		CHECK(statistics.elevation_minimum == -1.0f);
+	}
+
+}
+
+int main() {
+	WorldParameters parameters;
+	for (unsigned preset = 0; preset < WorldParameters::preset_list.size(); preset++) {
+		parameters.apply_preset(preset, false);
+		for (int determination : { Elevation_Based, Climate_Based }) {
+			parameters.biome_determination = determination;
+			test_classifier(parameters);
+		}
+	}
+	test_equal_colors();
+	return testing::result();
+}
@@ -0,0 +1,102 @@
+#include <fstream>
+
+#include <sethex/world/Cache.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace cinder;
+using namespace std;
+
+namespace {
+
+	shared<const StageOutputs> create_outputs(int width, int height) {
+		auto outputs = make_shared<StageOutputs>();
+		outputs->elevation_map = Channel32f::create(width, height);
+		outputs->temperature_map = Channel::create(width, height);
+		for (int row = 0; row < height; row++) {
+			for (int column = 0; column < width; column++) {
+				outputs->elevation_map->setValue(signed2(column, row), column * 0.25f - row);
+				outputs->temperature_map->setValue(signed2(column, row), static_cast<uint8>(column + row));
+			}
+		}
+		outputs->water_pixels = 7;
+		outputs->elevation_minimum = -1.5f;
+		outputs->elevation_maximum = 2.5f;
+		return outputs;
+	}
+
+	// spill file of "key", which is named by its hexadecimal digits
+	fs::path spill_file(const StageCache& cache, uint64 key) {
+		char name[32];
+		snprintf(name, sizeof(name), "%016llx.stage", static_cast<unsigned long long>(key));
+		return cache.get_spill_directory() / name;
+	}
+
+	void test_eviction(const fs::path& directory) {
+		auto outputs = create_outputs(16, 8);
+		StageCache cache(outputs->size());
+		cache.set_spill_directory(directory);
+		cache.clear();
+		cache.insert(1, outputs);
+		cache.insert(2, create_outputs(16, 8));
+		CHECK(cache.get_count() == 1);
+		CHECK(cache.get_used() <= cache.get_budget());
+		CHECK(cache.contains(1));
+		CHECK(fs::exists(spill_file(cache, 1)));
+
+		// the spilled outputs are read back unchanged
+		auto restored = cache.find(1);
+		CHECK(restored != nullptr);
+		if (restored) {
+			CHECK(restored->elevation_map and restored->elevation_map->getValue(signed2(5, 3)) == outputs->elevation_map->getValue(signed2(5, 3)));
+			CHECK(restored->temperature_map and restored->temperature_map->getValue(signed2(15, 7)) == 22);
+			CHECK(not restored->biome_map);
+			CHECK(restored->water_pixels == 7);
+			CHECK(restored->elevation_minimum == -1.5f and restored->elevation_maximum == 2.5f);
+		}
+		cache.clear();
+		CHECK(not cache.contains(1) and not cache.contains(2));
+	}
+
+	// overwrites the version, which follows the signature of four bytes
+	void change_version(const fs::path& path, uint32 version) {
+		fstream stream(path.string(), ios::binary | ios::in | ios::out);
+		stream.seekp(4);
+		stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	}
+
+	void test_outdated_spill(const fs::path& directory) {
+		StageCache cache(0);
+		cache.set_spill_directory(directory);
+		cache.clear();
+		cache.insert(3, create_outputs(4, 4));
+		CHECK(cache.get_count() == 0);
+		auto path = spill_file(cache, 3);
+		CHECK(fs::exists(path));
+
+		// a spill file of another version is a miss and removed, so the stage runs again
+		change_version(path, 2);
+		CHECK(cache.find(3) == nullptr);
+		CHECK(not fs::exists(path));
+		CHECK(not cache.contains(3));
+
+		// likewise a truncated file
+		cache.insert(4, create_outputs(4, 4));
+		path = spill_file(cache, 4);
+		fs::resize_file(path, fs::file_size(path) / 2);
+		CHECK(cache.find(4) == nullptr);
+		CHECK(not fs::exists(path));
+		cache.clear();
+	}
+
+}
+
+int main() {
+	auto directory = fs::temp_directory_path() / "sethex-cache-test";
+	test_eviction(directory);
+	test_outdated_spill(directory);
+	fs::remove_all(directory);
+	return testing::result();
+}
@@ -0,0 +1,116 @@
+#include <cmath>
+#include <random>
+
+#include <hexagonal/HierarchicalPathfinding.h>
+#include <hexagonal/Ranges.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	const unsigned Width = 200, Height = 120;
+
+	// terrain with costs between 1 and 3 per step, impassable ridges and slopes which make climbing expensive
+	struct Terrain {
+
+		hex::Map map;
+		Lot<float> base_costs;
+		Lot<float> elevations;
+
+		Terrain() : map(Width, Height, false), base_costs(Width * Height), elevations(Width * Height) {
+			for (unsigned row = 0; row < Height; row++) {
+				for (unsigned column = 0; column < Width; column++) {
+					float x = static_cast<float>(column), y = static_cast<float>(row);
+					float ridges = sin(x * 0.11f + 1.7f * sin(y * 0.05f)) * sin(y * 0.09f + 1.3f * sin(x * 0.04f));
+					base_costs[column + row * Width] = ridges > 0.8f ? Infinite_Cost : 2.0f + sin(x * 0.3f) * cos(y * 0.2f);
+					elevations[column + row * Width] = 4.0f * ridges;
+				}
+			}
+		}
+
+		TerrainCosts costs() const {
+			return TerrainCosts(map, base_costs.data(), elevations.data(), 0.5f);
+		}
+
+	};
+
+	float cost_of(const Lot<Cell>& path, const TerrainCosts& costs) {
+		float sum = 0.0f;
+		for (size_t step = 1; step < path.size(); step++) sum += costs(path[step - 1], path[step]);
+		return sum;
+	}
+
+	// paths are found whenever A* finds one, they are contiguous and cost at most a little more than those of A*
+	void check_queries(Terrain& terrain, HierarchicalPathfinder<TerrainCosts>& hierarchical, unsigned seed) {
+		auto costs = terrain.costs();
+		Pathfinder flat(terrain.map);
+		mt19937 random(seed);
+		uniform_int_distribution<unsigned> column(0, Width - 1), row(0, Height - 1);
+		Lot<Cell> path, expected;
+		double total = 0.0, expected_total = 0.0;
+		auto passable = [&](const Cell& cell) { return terrain.base_costs[terrain.map.index(cell)] < Infinite_Cost; };
+		for (unsigned query = 0; query < 200; query++) {
+			Cell start = terrain.map.at(column(random), row(random));
+			Cell goal = terrain.map.at(column(random), row(random));
+			// HPA* only leaves the start and enters the goal through passable cells
+			if (not passable(start) or not passable(goal)) continue;
+			bool found = hierarchical.find_path(start, goal, path);
+			CHECK(found == flat.find_path(start, goal, expected, costs, 1.0f));
+			if (not found) continue;
+			CHECK(path.front() == terrain.map.reproject(start));
+			CHECK(path.back() == terrain.map.reproject(goal));
+			for (size_t step = 1; step < path.size(); step++) {
+				CHECK(flat.distance(path[step - 1], path[step]) == 1);
+				CHECK(costs(path[step - 1], path[step]) < Infinite_Cost);
+			}
+			CHECK(cost_of(path, costs) >= cost_of(expected, costs) - 1e-3f);
+			total += cost_of(path, costs);
+			expected_total += cost_of(expected, costs);
+		}
+		CHECK(total <= 1.2 * expected_total);
+	}
+
+	void test_queries() {
+		Terrain terrain;
+		// small clusters and regions, so the queries cross several regions and the horizontal wrap
+		HierarchicalPathfinder<TerrainCosts> hierarchical(terrain.map, terrain.costs(), 1.0f, 8, 4);
+		CHECK(hierarchical.entrances() > hierarchical.region_entrances());
+		check_queries(terrain, hierarchical, 7);
+	}
+
+	// edits only rebuild the affected clusters and regions, which yields the same graph as building all of them
+	void test_edits() {
+		Terrain terrain;
+		HierarchicalPathfinder<TerrainCosts> hierarchical(terrain.map, terrain.costs(), 1.0f, 8, 4);
+		hierarchical.entrances();
+		mt19937 random(11);
+		uniform_int_distribution<unsigned> column(0, Width - 1), row(0, Height - 1);
+		for (unsigned edit = 0; edit < 40; edit++) {
+			Cell center = terrain.map.at(column(random), row(random));
+			for (auto& cell : spiral_range(2, center)) {
+				if (not terrain.map.contains_vertically(cell)) continue;
+				Cell reprojected = terrain.map.reproject(cell);
+				float& cost = terrain.base_costs[terrain.map.index(reprojected)];
+				cost = edit % 2 ? Infinite_Cost : 1.0f;
+				hierarchical.invalidate(reprojected);
+			}
+		}
+		unsigned entrances = hierarchical.entrances();
+		unsigned region_entrances = hierarchical.region_entrances();
+		check_queries(terrain, hierarchical, 13);
+		hierarchical.invalidate();
+		CHECK(hierarchical.entrances() == entrances);
+		CHECK(hierarchical.region_entrances() == region_entrances);
+	}
+
+}
+
+int main() {
+	test_queries();
+	test_edits();
+	return testing::result();
+}
@@ -0,0 +1,54 @@
+#include <stdexcept>
+
+#include <sethex/Parallel.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace std;
+
+namespace {
+
+	void test_coverage(ThreadPool& pool) {
+		Lot<atomic<int>> visits(1000);
+		for (auto& count : visits) count = 0;
+		pool.parallel_for(0, 1000, 7, [&](int index) { visits[index]++; });
+		bool once = true;
+		for (auto& count : visits) once &= count == 1;
+		CHECK(once);
+	}
+
+	void test_exception(ThreadPool& pool) {
+		bool thrown = false;
+		try {
+			pool.parallel_for(0, 1000, 10, [](int index) {
+				if (index == 503) throw runtime_error("task failed");
+			});
+		} catch (const runtime_error& exception) {
+			thrown = string(exception.what()) == "task failed";
+		}
+		CHECK(thrown);
+		// the workers survive the exception and run the next loop
+		test_coverage(pool);
+	}
+
+	void test_nested(ThreadPool& pool) {
+		atomic<int> sum { 0 };
+		pool.parallel_for(0, 16, 1, [&](int outer) {
+			pool.parallel_for(0, 16, 1, [&](int inner) { sum += outer * 16 + inner; });
+		});
+		CHECK(sum == 255 * 256 / 2);
+	}
+
+}
+
+int main() {
+	for (unsigned threads : { 0u, 1u, 3u }) {
+		ThreadPool pool(threads);
+		test_coverage(pool);
+		test_exception(pool);
+		test_nested(pool);
+	}
+	return testing::result();
+}
@@ -0,0 +1,108 @@
+#include <fstream>
+
+#include <sethex/world/Snapshot.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace cinder;
+using namespace std;
+
+namespace {
+
+	const int Width = 37, Height = 11;
+
+	void write_snapshot(const fs::path& path, WorldSnapshot::Elevation_Format format) {
+		WorldParameters parameters;
+		parameters.seed = 13;
+		parameters.biome_colors.rock = Color8u(1, 2, 3);
+		Channel32f elevation_map(Width, Height);
+		Channel temperature_map(Width, Height), precipitation_map(Width, Height);
+		Surface biome_map(Width, Height, false);
+		auto biomes = biome_map.getIter();
+		while (biomes.line()) while (biomes.pixel()) {
+			elevation_map.setValue(biomes.getPos(), (biomes.x() - biomes.y()) / 64.0f);
+			temperature_map.setValue(biomes.getPos(), static_cast<uint8>(biomes.x()));
+			precipitation_map.setValue(biomes.getPos(), static_cast<uint8>(biomes.y()));
+			auto color = biomes.x() < Width / 2 ? parameters.biome_colors.rock : parameters.biome_colors.ocean;
+			biomes.r() = color.r;
+			biomes.g() = color.g;
+			biomes.b() = color.b;
+		}
+		WorldSnapshot::write(path, parameters, elevation_map, temperature_map, precipitation_map, biome_map, format);
+	}
+
+	void test_round_trip(const fs::path& path) {
+		for (auto format : { WorldSnapshot::Float32, WorldSnapshot::Int16 }) {
+			write_snapshot(path, format);
+			WorldSnapshot snapshot(path);
+			CHECK(snapshot.get_size() == unsigned2(Width, Height));
+			CHECK(snapshot.get_elevation_format() == format);
+			CHECK(snapshot.get_parameters().seed == 13);
+			CHECK(snapshot.get_parameters().biome_colors.rock == Color8u(1, 2, 3));
+			float elevation = snapshot.get_elevation_map()->getValue(signed2(30, 2));
+			CHECK(abs(elevation - 28 / 64.0f) <= (format == WorldSnapshot::Int16 ? 1.0f / 32767 : 0.0f));
+			CHECK(snapshot.get_temperature_map()->getValue(signed2(30, 2)) == 30);
+			CHECK(snapshot.get_precipitation_map()->getValue(signed2(30, 2)) == 2);
+			// the biomes are stored as the ids of the colors of the parameters
+			auto& colors = snapshot.get_parameters().biome_colors;
+			CHECK(snapshot.get_biome_ids()->getValue(signed2(0, 5)) == colors.get_id(colors.rock));
+			CHECK(snapshot.get_biome_ids()->getValue(signed2(Width - 1, 5)) == colors.get_id(colors.ocean));
+		}
+	}
+
+	// whether opening the snapshot throws once its header has been changed
+	template<class Change>
+	bool rejects(const fs::path& path, Change change) {
+		write_snapshot(path, WorldSnapshot::Float32);
+		WorldSnapshot::Header header;
+		{
+			fstream stream(path.string(), ios::binary | ios::in | ios::out);
+			stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+			change(header);
+			stream.seekp(0);
+			stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		}
+		try {
+			WorldSnapshot snapshot(path);
+		} catch (const exception&) {
+			return true;
+		}
+		return false;
+	}
+
+	void test_validation(const fs::path& path) {
+		using Header = WorldSnapshot::Header;
+		CHECK(not rejects(path, [](Header&) {}));
+		CHECK(rejects(path, [](Header& header) { header.version++; }));
+		CHECK(rejects(path, [](Header& header) { header.width = 0; }));
+		CHECK(rejects(path, [](Header& header) { header.height = 0xFFFFFFFF; }));
+		// pixels whose sizes overflow 64 bit once they are multiplied by the size of a float
+		CHECK(rejects(path, [](Header& header) { header.width = header.height = 0x80000000; }));
+		CHECK(rejects(path, [](Header& header) { header.width = header.height = 0x20000000; }));
+		// offsets and sizes whose sums overflow
+		CHECK(rejects(path, [](Header& header) { header.parameters_size = 0xFFFFFFFFFFFFFFFFull; }));
+		CHECK(rejects(path, [](Header& header) { header.layer_offsets[WorldSnapshot::Biome_Ids] = 0xFFFFFFFFFFFFF000ull; }));
+		CHECK(rejects(path, [](Header& header) { header.layer_offsets[WorldSnapshot::Temperature] += WorldSnapshot::Layer_Alignment; }));
+		// truncated file
+		write_snapshot(path, WorldSnapshot::Float32);
+		fs::resize_file(path, fs::file_size(path) - 1);
+		bool thrown = false;
+		try {
+			WorldSnapshot snapshot(path);
+		} catch (const exception&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+	}
+
+}
+
+int main() {
+	auto path = fs::temp_directory_path() / "sethex-snapshot-test.snapshot";
+	test_round_trip(path);
+	test_validation(path);
+	fs::remove(path);
+	return testing::result();
+}
@@ -0,0 +1,143 @@
+#include <sstream>
+
+#include <sethex/world/Stages.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::sethex;
+using namespace std;
+
+using Stage = GenerationStages::Stage;
+
+namespace {
+
+	const unsigned2 Resolution(800, 450);
+
+	// keys of the stages producing maps
+	struct Keys {
+
+		uint64 keys[GenerationStages::Display];
+
+		explicit Keys(const GenerationSettings& settings) {
+			for (int stage = 0; stage < GenerationStages::Display; stage++) {
+				keys[stage] = GenerationStages::key(settings, static_cast<Stage>(stage), Resolution, 1);
+			}
+		}
+
+		// whether exactly the stages from "first" on have different keys
+		bool differ_from(const Keys& other, Stage first) const {
+			for (int stage = 0; stage < GenerationStages::Display; stage++) {
+				if ((keys[stage] != other.keys[stage]) != (stage >= first)) return false;
+			}
+			return true;
+		}
+
+	};
+
+	void test_dirty_flags() {
+		GenerationStages stages;
+		CHECK(stages.dirty(GenerationStages::Tectonic));
+		CHECK(stages.settings_changed());
+
+		// completing a stage marks its dependent, until the display is reached
+		struct Completion : GenerationStages {
+			using GenerationStages::complete;
+		} completion;
+		for (int stage = GenerationStages::Tectonic; stage < GenerationStages::Display; stage++) {
+			completion.complete(static_cast<Stage>(stage));
+			CHECK(not completion.dirty(static_cast<Stage>(stage)));
+			CHECK(completion.dirty(GenerationStages::dependent(static_cast<Stage>(stage))));
+		}
+		CHECK(not completion.settings_changed());
+		CHECK(completion.dirty(GenerationStages::Display));
+		CHECK(GenerationStages::dependent(GenerationStages::Display) == GenerationStages::Display);
+
+		// a dirty stage of the interface counts as changed settings, unlike the display
+		completion.dirty(GenerationStages::Display) = false;
+		completion.dirty(GenerationStages::Climate) = true;
+		CHECK(completion.settings_changed());
+		completion.complete(GenerationStages::Climate);
+		CHECK(completion.dirty(GenerationStages::Biomes));
+		completion.complete(GenerationStages::Biomes);
+		CHECK(not completion.settings_changed());
+	}
+
+	void test_keys() {
+		GenerationSettings settings;
+		Keys original(settings);
+		CHECK(original.differ_from(Keys(settings), GenerationStages::Display));
+
+		// the resolution is an input of all stages
+		CHECK(GenerationStages::key(settings, GenerationStages::Tectonic, Resolution, 4) != original.keys[GenerationStages::Tectonic]);
+
+		auto changed = settings;
+		changed.parameters.seed = 7;
+		CHECK(Keys(changed).differ_from(original, GenerationStages::Tectonic));
+
+		changed = settings;
+		changed.parameters.sealevel = 0.25f;
+		CHECK(Keys(changed).differ_from(original, GenerationStages::Topography));
+
+		changed = settings;
+		changed.circulation_type = Linear;
+		CHECK(Keys(changed).differ_from(original, GenerationStages::Topography));
+
+		changed = settings;
+		changed.parameters.humidity_saturation = 40.0f;
+		CHECK(Keys(changed).differ_from(original, GenerationStages::Climate));
+
+		changed = settings;
+		changed.parameters.biome_determination = Elevation_Based;
+		CHECK(Keys(changed).differ_from(original, GenerationStages::Biomes));
+
+		// the colors are part of the parameters, so two pipelines with different colors don't share their biomes
+		changed = settings;
+		changed.parameters.biome_colors.ocean = ci::Color8u(0, 0, 255);
+		CHECK(Keys(changed).differ_from(original, GenerationStages::Biomes));
+
+		// the seed doesn't matter for elevation maps
+		settings.elevation_source = Elevation_Map;
+		settings.height_file = "height.png";
+		changed = settings;
+		changed.parameters.seed = 7;
+		CHECK(Keys(changed).differ_from(Keys(settings), GenerationStages::Display));
+		changed.height_scale = 2.0f;
+		CHECK(Keys(changed).differ_from(Keys(settings), GenerationStages::Tectonic));
+	}
+
+	void test_parameters() {
+		WorldParameters parameters;
+		parameters.apply_preset(3, false);
+		parameters.seed = 42;
+		parameters.biome_colors.ice = ci::Color8u(250, 251, 252);
+		parameters.biome_colors.deep_ocean = ci::Color8u(0, 0, 1);
+		stringstream stream;
+		parameters.write(stream);
+		WorldParameters read;
+		read.read(stream);
+		CHECK(read.seed == 42);
+		CHECK(read.sealevel == parameters.sealevel);
+		CHECK(read.thresholds == parameters.thresholds);
+		CHECK(read.biome_colors.ice == parameters.biome_colors.ice);
+		CHECK(read.biome_colors.deep_ocean == parameters.biome_colors.deep_ocean);
+		CHECK(read.get_biome_determination().colors.get_id(ci::Color8u(250, 251, 252)) == 2);
+
+		stringstream invalid("color_ice = 256 0 0\n");
+		bool thrown = false;
+		try {
+			read.read(invalid);
+		} catch (const exception&) {
+			thrown = true;
+		}
+		CHECK(thrown);
+	}
+
+}
+
+int main() {
+	test_dirty_flags();
+	test_keys();
+	test_parameters();
+	return testing::result();
+}
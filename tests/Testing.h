@@ -0,0 +1,27 @@
+#pragma once
+
+#include <iostream>
+
+// Checks of the tests, which report failed conditions and make the test return a non-zero exit code.
+namespace testing {
+
+	inline int& failures() {
+		static int count = 0;
+		return count;
+	}
+
+	inline void check(bool condition, const char* expression, const char* file, int line) {
+		if (condition) return;
+		std::cerr << file << ':' << line << ": check failed: " << expression << std::endl;
+		failures()++;
+	}
+
+	// exit code of the test
+	inline int result() {
+		if (failures()) std::cerr << failures() << " checks failed" << std::endl;
+		return failures() ? 1 : 0;
+	}
+
+}
+
+#define CHECK(condition) testing::check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
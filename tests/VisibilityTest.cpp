@@ -0,0 +1,89 @@
+#include <cmath>
+#include <unordered_set>
+
+#include <hexagonal/Visibility.h>
+
+#include "Testing.h"
+
+using namespace tenjix;
+using namespace tenjix::hexagonal;
+using namespace std;
+
+namespace {
+
+	const unsigned Width = 64, Height = 64, Radius = 10;
+
+	unordered_set<Cell> set_of(const Lot<Cell>& cells) {
+		return unordered_set<Cell>(cells.begin(), cells.end());
+	}
+
+	// cells of "one" which are missing in "other"
+	unordered_set<Cell> difference(const unordered_set<Cell>& one, const unordered_set<Cell>& other) {
+		unordered_set<Cell> result;
+		for (auto& cell : one) if (not other.count(cell)) result.insert(cell);
+		return result;
+	}
+
+	// on flat terrain every cell within the radius is visible exactly once
+	void test_flat(const hex::Map& map) {
+		Lot<float> heights(map.width() * map.height(), 0.0f);
+		FieldOfView field_of_view(map, Radius);
+		Cell viewer = map.at(Width / 2, Height / 2);
+		Lot<Cell> visible;
+		field_of_view.compute(viewer, Radius, 1.0f, TerrainElevations(map, heights.data()), visible);
+		CHECK(visible.size() == 331);
+		CHECK(set_of(visible).size() == visible.size());
+		for (auto& cell : visible) CHECK(distance(cell, viewer) <= Radius);
+	}
+
+	// a ring wall around the viewer hides everything behind it
+	void test_wall(const hex::Map& map) {
+		const unsigned Wall = 5;
+		Lot<float> heights(map.width() * map.height(), 0.0f);
+		Cell viewer = map.at(Width / 2, Height / 2);
+		for (auto& cell : ring_range(Wall, viewer)) heights[map.index(cell)] = 10.0f;
+		FieldOfView field_of_view(map, Radius);
+		Lot<Cell> visible;
+		field_of_view.compute(viewer, Radius, 1.0f, TerrainElevations(map, heights.data()), visible);
+		CHECK(visible.size() == 3 * Wall * (Wall + 1) + 1);
+		for (auto& cell : visible) CHECK(distance(cell, viewer) <= Wall);
+	}
+
+	// the changes reported by recompute are the differences between the fields of view before and after a move
+	void test_recompute(const hex::Map& map) {
+		Lot<float> heights(map.width() * map.height());
+		for (unsigned row = 0; row < map.height(); row++) {
+			for (unsigned column = 0; column < map.width(); column++) {
+				heights[column + row * map.width()] = 3.0f * sin(column * 0.4f) * sin(row * 0.3f) + sin(column * 1.3f + row * 0.7f);
+			}
+		}
+		TerrainElevations elevations(map, heights.data());
+		FieldOfView field_of_view(map, Radius);
+		Cell viewer = map.at(Width / 2, Height / 2);
+		Lot<Cell> visible, before, after, entered, left;
+		field_of_view.compute(viewer, Radius, 1.0f, elevations, visible);
+		size_t changes = 0;
+		for (unsigned step = 0; step < 12; step++) {
+			before = visible;
+			viewer += static_cast<Direction>(step % 6);
+			field_of_view.recompute(viewer, Radius, 1.0f, elevations, visible, entered, left);
+			field_of_view.compute(viewer, Radius, 1.0f, elevations, after);
+			CHECK(set_of(visible) == set_of(after));
+			CHECK(set_of(entered) == difference(set_of(after), set_of(before)));
+			CHECK(set_of(left) == difference(set_of(before), set_of(after)));
+			CHECK(entered.size() == set_of(entered).size());
+			CHECK(left.size() == set_of(left).size());
+			changes += entered.size() + left.size();
+		}
+		CHECK(changes > 0);
+	}
+
+}
+
+int main() {
+	hex::Map map(Width, Height, false);
+	test_flat(map);
+	test_wall(map);
+	test_recompute(map);
+	return testing::result();
+}